@@ -0,0 +1,356 @@
+#include "shared_memory.h"
+#include "sync_utils.h"
+#include "bench_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <sys/wait.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/*
+ * Benchmark de las primitivas de IPC sobre las que está construido el protocolo de turnos (make ipcbench).
+ * Todas las mediciones son entre dos procesos (o un escritor y N lectores) y usan memoria compartida
+ * anónima, así que pueden correr en paralelo con una partida sin tocar /game_state ni /game_sync.
+ *
+ * - Ping-pong (ida y vuelta): allow_player_move/wait_player_turn, notify_view/wait_view_done, pipe de un
+ *   byte, eventfd, futex y un ring en memoria compartida con espera activa.
+ * - Contención lectores-escritores: 1 a 9 lectores en reader_enter/reader_exit contra un escritor en
+ *   writer_enter, con el protocolo de semáforos y con el lock robusto.
+ *
+ * Uso: bench_ipc [-n idas_y_vueltas] [-m ms_por_medición]
+ */
+
+#define DEFAULT_ROUNDS 20000
+#define DEFAULT_RW_MS 300
+#define RING_SLOTS 64
+#define RING_SPINS_BEFORE_YIELD 128
+
+typedef struct
+{
+    _Atomic uint64_t head;
+    char pad[CACHE_LINE_SIZE - sizeof(uint64_t)];
+    _Atomic uint64_t tail;
+    char pad2[CACHE_LINE_SIZE - sizeof(uint64_t)];
+    uint64_t slots[RING_SLOTS];
+} spsc_ring_t;
+
+typedef struct
+{
+    game_sync_t sync;
+    robust_rwlock_t robust_lock;
+    _Atomic uint32_t futex_word[2];
+    spsc_ring_t ring[2];
+    volatile bool stop;
+    unsigned long long reader_ops[MAX_PLAYERS];
+    int board[1024]; // Datos que leen los lectores y escribe el escritor
+} ipc_shared_t;
+
+// Transporte para ping-pong: dir 0 = padre -> hijo, dir 1 = hijo -> padre
+typedef struct
+{
+    const char *name;
+    void (*send)(int dir);
+    void (*recv)(int dir);
+} transport_t;
+
+static ipc_shared_t *shared;
+static int pipe_fds[2][2];
+static int event_fds[2];
+static int rounds = DEFAULT_ROUNDS;
+static int rw_ms = DEFAULT_RW_MS;
+static bench_stats_t stats;
+
+/* === Transportes === */
+
+static void sem_send(int dir) { allow_player_move(&shared->sync, dir); }
+static void sem_recv(int dir) { wait_player_turn(&shared->sync, dir); }
+
+static void view_send(int dir)
+{
+    if (dir == 0)
+        notify_view(&shared->sync);
+    else
+        notify_view_done(&shared->sync);
+}
+
+static void view_recv(int dir)
+{
+    if (dir == 0)
+        wait_view_notification(&shared->sync);
+    else
+        wait_view_done(&shared->sync);
+}
+
+static void pipe_send(int dir)
+{
+    unsigned char byte = 1;
+    if (write(pipe_fds[dir][1], &byte, 1) != 1)
+        perror("write (pipe)");
+}
+
+static void pipe_recv(int dir)
+{
+    unsigned char byte;
+    if (read(pipe_fds[dir][0], &byte, 1) != 1)
+        perror("read (pipe)");
+}
+
+static void eventfd_send(int dir)
+{
+    uint64_t one = 1;
+    if (write(event_fds[dir], &one, sizeof(one)) != sizeof(one))
+        perror("write (eventfd)");
+}
+
+static void eventfd_recv(int dir)
+{
+    uint64_t value;
+    if (read(event_fds[dir], &value, sizeof(value)) != sizeof(value))
+        perror("read (eventfd)");
+}
+
+static void futex_send(int dir)
+{
+    atomic_store_explicit(&shared->futex_word[dir], 1, memory_order_release);
+    syscall(SYS_futex, &shared->futex_word[dir], FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+static void futex_recv(int dir)
+{
+    while (atomic_exchange_explicit(&shared->futex_word[dir], 0, memory_order_acquire) == 0)
+        syscall(SYS_futex, &shared->futex_word[dir], FUTEX_WAIT, 0, NULL, NULL, 0);
+}
+
+static void ring_send(int dir)
+{
+    spsc_ring_t *ring = &shared->ring[dir];
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    while (head - atomic_load_explicit(&ring->tail, memory_order_acquire) >= RING_SLOTS)
+        sched_yield();
+    ring->slots[head % RING_SLOTS] = head;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+static void ring_recv(int dir)
+{
+    spsc_ring_t *ring = &shared->ring[dir];
+    uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    for (int spins = 0; atomic_load_explicit(&ring->head, memory_order_acquire) == tail; ++spins)
+    {
+        if (spins >= RING_SPINS_BEFORE_YIELD)
+            sched_yield();
+    }
+    (void)ring->slots[tail % RING_SLOTS];
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+static const transport_t transports[] = {
+    {"sem (allow/wait_turn)", sem_send, sem_recv},
+    {"sem (notify_view)", view_send, view_recv},
+    {"pipe 1 byte", pipe_send, pipe_recv},
+    {"eventfd", eventfd_send, eventfd_recv},
+    {"futex", futex_send, futex_recv},
+    {"shm ring (spin)", ring_send, ring_recv},
+};
+
+/* === Mediciones === */
+
+static void print_latency(const char *name, const char *detail, double total_ns, size_t ops)
+{
+    printf("%-22s %-12s %10.0f %9.0f %9.0f %9.0f %10.0f %12.0f\n",
+           name, detail,
+           bench_stats_percentile(&stats, 50), bench_stats_percentile(&stats, 90),
+           bench_stats_percentile(&stats, 99), bench_stats_percentile(&stats, 99.9),
+           bench_stats_percentile(&stats, 100),
+           total_ns > 0 ? ops / (total_ns / 1e9) : 0.0);
+    fflush(stdout);
+}
+
+static void run_pingpong(const transport_t *t)
+{
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        perror("fork");
+        return;
+    }
+    if (pid == 0)
+    {
+        for (int i = 0; i < rounds; ++i)
+        {
+            t->recv(0);
+            t->send(1);
+        }
+        _exit(0);
+    }
+
+    bench_stats_reset(&stats);
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < rounds; ++i)
+    {
+        uint64_t t0 = bench_now_ns();
+        t->send(0);
+        t->recv(1);
+        bench_stats_add(&stats, (double)(bench_now_ns() - t0));
+    }
+    uint64_t total = bench_now_ns() - start;
+    waitpid(pid, NULL, 0);
+    print_latency(t->name, "round trip", (double)total, rounds);
+}
+
+static void reader_loop(int id)
+{
+    unsigned long long ops = 0;
+    int sum = 0;
+    while (!shared->stop)
+    {
+        reader_enter(&shared->sync);
+        for (int i = 0; i < 64; ++i)
+            sum += shared->board[(id * 64 + i) % 1024];
+        reader_exit(&shared->sync);
+        ops++;
+    }
+    shared->reader_ops[id] = ops + (sum == 42);
+}
+
+static void run_rw_contention(int readers, bool robust)
+{
+    shared->stop = false;
+    if (robust)
+        sync_use_robust_lock(&shared->robust_lock);
+
+    pid_t pids[MAX_PLAYERS];
+    for (int r = 0; r < readers; ++r)
+    {
+        shared->reader_ops[r] = 0;
+        pids[r] = fork();
+        if (pids[r] == 0)
+        {
+            reader_loop(r);
+            sync_release_robust_lock();
+            _exit(0);
+        }
+    }
+
+    bench_stats_reset(&stats);
+    size_t writes = 0;
+    uint64_t start = bench_now_ns();
+    uint64_t deadline = start + (uint64_t)rw_ms * 1000000ull;
+    while (bench_now_ns() < deadline && stats.count < stats.capacity)
+    {
+        uint64_t t0 = bench_now_ns();
+        writer_enter(&shared->sync);
+        bench_stats_add(&stats, (double)(bench_now_ns() - t0));
+        shared->board[writes % 1024]++;
+        writer_exit(&shared->sync);
+        writes++;
+        sched_yield(); // El master no escribe en ráfaga: entre movimientos lee pipes y notifica
+    }
+    uint64_t total = bench_now_ns() - start;
+    shared->stop = true;
+
+    unsigned long long reader_ops = 0;
+    for (int r = 0; r < readers; ++r)
+    {
+        waitpid(pids[r], NULL, 0);
+        reader_ops += shared->reader_ops[r];
+    }
+    sync_release_robust_lock();
+
+    char detail[32];
+    snprintf(detail, sizeof(detail), "%d readers", readers);
+    print_latency(robust ? "writer_enter (robust)" : "writer_enter (sem)", detail, (double)total, writes);
+    printf("%-22s %-12s %64.0f\n", "", "reader ops/s", reader_ops / (total / 1e9));
+}
+
+static int init_shared(void)
+{
+    shared = mmap(NULL, sizeof(ipc_shared_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED)
+    {
+        perror("mmap");
+        return -1;
+    }
+    memset(shared, 0, sizeof(*shared));
+
+    game_sync_t *sync = &shared->sync;
+    if (sem_init(&sync->update_view_sem, 1, 0) == -1 || sem_init(&sync->view_done_sem, 1, 0) == -1 ||
+        sem_init(&sync->master_access_mutex, 1, 1) == -1 || sem_init(&sync->game_state_mutex, 1, 1) == -1 ||
+        sem_init(&sync->readers_count_mutex, 1, 1) == -1)
+    {
+        perror("sem_init");
+        return -1;
+    }
+    for (int i = 0; i < MAX_PLAYERS; ++i)
+    {
+        if (sem_init(&sync->player_move_sem[i], 1, 0) == -1)
+        {
+            perror("sem_init player_move_sem");
+            return -1;
+        }
+    }
+    if (init_robust_lock(&shared->robust_lock) != 0)
+        return -1;
+
+    if (pipe(pipe_fds[0]) == -1 || pipe(pipe_fds[1]) == -1)
+    {
+        perror("pipe");
+        return -1;
+    }
+    event_fds[0] = eventfd(0, 0);
+    event_fds[1] = eventfd(0, 0);
+    if (event_fds[0] == -1 || event_fds[1] == -1)
+    {
+        perror("eventfd");
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int opt;
+    while ((opt = getopt(argc, argv, "n:m:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            rounds = atoi(optarg);
+            break;
+        case 'm':
+            rw_ms = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Uso: %s [-n idas_y_vueltas] [-m ms_por_medición]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (rounds < 1)
+        rounds = DEFAULT_ROUNDS;
+    if (rw_ms < 1)
+        rw_ms = DEFAULT_RW_MS;
+
+    if (init_shared() != 0)
+        return EXIT_FAILURE;
+    // Alcanza para las idas y vueltas y para los intentos de escritura de cada medición de contención
+    if (bench_stats_init(&stats, rounds > 1000000 ? (size_t)rounds : 1000000) != 0)
+        return EXIT_FAILURE;
+
+    printf("%-22s %-12s %10s %9s %9s %9s %10s %12s\n",
+           "primitive", "", "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "max ns", "ops/s");
+    for (size_t i = 0; i < sizeof(transports) / sizeof(transports[0]); ++i)
+        run_pingpong(&transports[i]);
+
+    for (int robust = 0; robust <= 1; ++robust)
+        for (int readers = 1; readers <= MAX_PLAYERS; ++readers)
+            run_rw_contention(readers, robust);
+
+    bench_stats_free(&stats);
+    return EXIT_SUCCESS;
+}
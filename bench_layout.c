@@ -0,0 +1,128 @@
+#include "shared_memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <stdint.h>
+#include <sched.h>
+
+/*
+ * Mide el costo de coherencia de caché del formato de player_t: un hilo hace de master escribiendo los
+ * campos calientes del jugador 0 y otros hilos leen lo que leen la vista y los jugadores en cada acceso:
+ * las dimensiones del tablero y la cantidad de jugadores (BOARD_CELL, recorridos), el nombre del jugador 1
+ * y los campos calientes de su propio jugador. En el formato de la especificación las dimensiones, la
+ * cantidad y el nombre del jugador 1 comparten línea con los campos calientes del jugador 0. Se compila dos
+ * veces (make layout-bench): con el formato de la especificación y con SPLIT_PLAYER_LAYOUT.
+ *
+ * Cada hilo cuenta en una variable local y guarda el total al terminar, para que los contadores del propio
+ * benchmark no compartan línea entre hilos. Sin al menos un CPU por hilo no hay tráfico de coherencia que
+ * medir, y se avisa.
+ */
+
+#define DEFAULT_READERS 3
+#define DEFAULT_DURATION_MS 1000
+
+static game_state_t *state;
+static volatile bool running = true;
+
+typedef struct
+{
+    int player_idx;
+    unsigned long long ops; // Se escribe una sola vez, al terminar
+} __attribute__((aligned(CACHE_LINE_SIZE))) bench_thread_t;
+
+static void *writer_thread(void *arg)
+{
+    bench_thread_t *t = arg;
+    player_hot_t *hot = PLAYER_HOT(state, t->player_idx);
+    unsigned long long ops = 0;
+    while (running)
+    {
+        __atomic_store_n(&hot->score, hot->score + 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&hot->valid_moves, hot->valid_moves + 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&hot->pos_x, (unsigned short)(hot->pos_x + 1), __ATOMIC_RELAXED);
+        ops++;
+    }
+    t->ops = ops;
+    return NULL;
+}
+
+static void *reader_thread(void *arg)
+{
+    bench_thread_t *t = arg;
+    player_hot_t *hot = PLAYER_HOT(state, t->player_idx);
+    const char *name = state->players[1].player_name;
+    unsigned long long ops = 0, sink = 0;
+    while (running)
+    {
+        sink += __atomic_load_n(&state->board_width, __ATOMIC_RELAXED);
+        sink += __atomic_load_n(&state->board_height, __ATOMIC_RELAXED);
+        sink += __atomic_load_n(&state->player_count, __ATOMIC_RELAXED);
+        sink += (unsigned char)__atomic_load_n(&name[0], __ATOMIC_RELAXED);
+        sink += __atomic_load_n(&hot->score, __ATOMIC_RELAXED);
+        sink += __atomic_load_n(&hot->pos_x, __ATOMIC_RELAXED);
+        sink += __atomic_load_n(&hot->is_blocked, __ATOMIC_RELAXED);
+        ops++;
+    }
+    t->ops = ops;
+    return (void *)(uintptr_t)sink;
+}
+
+int main(int argc, char *argv[])
+{
+    int readers = argc > 1 ? atoi(argv[1]) : DEFAULT_READERS;
+    int duration_ms = argc > 2 ? atoi(argv[2]) : DEFAULT_DURATION_MS;
+    if (readers < 1 || readers > MAX_PLAYERS - 1)
+        readers = DEFAULT_READERS;
+
+    size_t size = calculate_game_state_size(10, 10);
+    state = aligned_alloc(CACHE_LINE_SIZE, (size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE);
+    if (state == NULL)
+    {
+        perror("aligned_alloc");
+        return EXIT_FAILURE;
+    }
+    memset(state, 0, size);
+
+    cpu_set_t cpus;
+    if (sched_getaffinity(0, sizeof(cpus), &cpus) == 0 && CPU_COUNT(&cpus) < readers + 1)
+        fprintf(stderr, "Advertencia: %d CPUs para %d hilos; los hilos se turnan y no hay tráfico de coherencia que medir\n",
+                CPU_COUNT(&cpus), readers + 1);
+
+    pthread_t threads[MAX_PLAYERS];
+    bench_thread_t args[MAX_PLAYERS] = {{0}};
+    args[0].player_idx = 0;
+    pthread_create(&threads[0], NULL, writer_thread, &args[0]);
+    for (int r = 1; r <= readers; ++r)
+    {
+        args[r].player_idx = r;
+        pthread_create(&threads[r], NULL, reader_thread, &args[r]);
+    }
+
+    struct timespec ts = {duration_ms / 1000, (duration_ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+    running = false;
+
+    unsigned long long reader_ops = 0;
+    for (int r = 0; r <= readers; ++r)
+    {
+        pthread_join(threads[r], NULL);
+        if (r > 0)
+            reader_ops += args[r].ops;
+    }
+
+    double secs = duration_ms / 1000.0;
+#ifdef SPLIT_PLAYER_LAYOUT
+    const char *layout = "split";
+#else
+    const char *layout = "packed";
+#endif
+    printf("%-6s sizeof(player_hot_t)=%3zu  writer %8.2f Mops/s (%6.2f ns/op)  %d readers %8.2f Mops/s (%6.2f ns/op)\n",
+           layout, sizeof(player_hot_t),
+           args[0].ops / secs / 1e6, secs * 1e9 / (args[0].ops ? args[0].ops : 1),
+           readers, reader_ops / secs / 1e6, secs * 1e9 * readers / (reader_ops ? reader_ops : 1));
+
+    free(state);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,266 @@
+#include "master_lib.h"
+#include "bench_utils.h"
+
+/*
+ * Microbenchmarks de las funciones de reglas de master_lib.c sobre tableros sintéticos, sin procesos ni IPC
+ * de por medio (make microbench). Cada medición se repite BENCH_RUNS veces y se informa ns/op promedio,
+ * desvío estándar y mínimo. Con -c se agregan contadores de hardware por operación (perf_event_open).
+ *
+ * Uso: bench_rules [-c] [-q]    (-q: sólo tableros chicos, para una corrida rápida)
+ */
+
+#define BENCH_RUNS 11
+#define BENCH_TARGET_NS 5000000ull // Duración aproximada de cada corrida
+#define RANDOM_TABLE_SIZE 4096     // Potencia de dos
+
+static const int DIR_OFFSETS[8][2] = {
+    {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}
+};
+
+static char *player_paths[MAX_PLAYERS] = {
+    "bench0", "bench1", "bench2", "bench3", "bench4", "bench5", "bench6", "bench7", "bench8"
+};
+
+typedef struct
+{
+    game_state_t *state;
+    unsigned short pos_x[RANDOM_TABLE_SIZE];
+    unsigned short pos_y[RANDOM_TABLE_SIZE];
+    unsigned char dir[RANDOM_TABLE_SIZE];
+} bench_ctx_t;
+
+typedef void (*kernel_fn)(bench_ctx_t *ctx, uint64_t iters);
+
+static bench_perf_t perf;
+static bench_stats_t stats;
+static volatile int sink;
+
+static game_state_t *make_board(unsigned short width, unsigned short height, int fill_pct)
+{
+    game_state_t *state = calloc(1, calculate_game_state_size(width, height));
+    if (state == NULL)
+    {
+        perror("calloc (tablero)");
+        exit(EXIT_FAILURE);
+    }
+    state->board_width = width;
+    state->board_height = height;
+    board_init_border(state);
+    initialize_game_state(state, player_paths, MAX_PLAYERS, 1234, NULL);
+
+    // Capturar fill_pct % de las celdas para simular distintos momentos de la partida
+    srand(5678);
+    for (unsigned short y = 0; y < height; ++y)
+        for (unsigned short x = 0; x < width; ++x)
+            if (rand() % 100 < fill_pct)
+                BOARD_CELL(state, x, y) = -(rand() % MAX_PLAYERS);
+    return state;
+}
+
+static void fill_random_tables(bench_ctx_t *ctx)
+{
+    srand(91011);
+    for (int i = 0; i < RANDOM_TABLE_SIZE; ++i)
+    {
+        ctx->pos_x[i] = (unsigned short)(rand() % ctx->state->board_width);
+        ctx->pos_y[i] = (unsigned short)(rand() % ctx->state->board_height);
+        ctx->dir[i] = (unsigned char)(rand() % 8);
+    }
+}
+
+static void kernel_process_player_move(bench_ctx_t *ctx, uint64_t iters)
+{
+    game_state_t *state = ctx->state;
+    player_hot_t *player = PLAYER_HOT(state, 0);
+    player->is_blocked = false;
+    for (uint64_t i = 0; i < iters; ++i)
+    {
+        unsigned int r = i & (RANDOM_TABLE_SIZE - 1);
+        player->pos_x = ctx->pos_x[r];
+        player->pos_y = ctx->pos_y[r];
+        if (process_player_move(state, NULL, 0, ctx->dir[r], DIR_OFFSETS))
+        {
+            // Devolver la celda capturada para mantener el nivel de ocupación
+            BOARD_CELL(state, player->pos_x, player->pos_y) = 5;
+        }
+    }
+}
+
+static void kernel_update_lock_status(bench_ctx_t *ctx, uint64_t iters)
+{
+    game_state_t *state = ctx->state;
+    for (uint64_t i = 0; i < iters; ++i)
+    {
+        for (int p = 0; p < MAX_PLAYERS; ++p)
+        {
+            unsigned int r = (i * MAX_PLAYERS + p) & (RANDOM_TABLE_SIZE - 1);
+            player_hot_t *player = PLAYER_HOT(state, p);
+            player->pos_x = ctx->pos_x[r];
+            player->pos_y = ctx->pos_y[r];
+            player->is_blocked = false;
+        }
+        update_lock_status(state, NULL, DIR_OFFSETS, true);
+    }
+}
+
+static void kernel_all_players_blocked(bench_ctx_t *ctx, uint64_t iters)
+{
+    game_state_t *state = ctx->state;
+    // Peor caso: sólo el último jugador sigue libre
+    for (int p = 0; p < MAX_PLAYERS; ++p)
+        PLAYER_HOT(state, p)->is_blocked = (p != MAX_PLAYERS - 1);
+    for (uint64_t i = 0; i < iters; ++i)
+    {
+        sink += all_players_blocked(state);
+        __asm__ volatile("" ::: "memory");
+    }
+}
+
+static void kernel_initialize_game_state(bench_ctx_t *ctx, uint64_t iters)
+{
+    for (uint64_t i = 0; i < iters; ++i)
+        initialize_game_state(ctx->state, player_paths, MAX_PLAYERS, (unsigned int)i, NULL);
+}
+
+static void kernel_compute_winner(bench_ctx_t *ctx, uint64_t iters)
+{
+    game_state_t *state = ctx->state;
+    for (int p = 0; p < MAX_PLAYERS; ++p)
+    {
+        PLAYER_HOT(state, p)->score = 100 + (p * 7) % 5;
+        PLAYER_HOT(state, p)->valid_moves = 20 + (p * 3) % 4;
+        PLAYER_HOT(state, p)->invalid_moves = p;
+    }
+    for (uint64_t i = 0; i < iters; ++i)
+    {
+        sink += compute_winner(state);
+        __asm__ volatile("" ::: "memory");
+    }
+}
+
+static void kernel_board_stats(bench_ctx_t *ctx, uint64_t iters)
+{
+    board_stats_t board;
+    for (uint64_t i = 0; i < iters; ++i)
+    {
+        board_stats_compute(ctx->state, &board);
+        sink += (int)board.free_cells;
+    }
+}
+
+static void run_bench(const char *name, kernel_fn kernel, bench_ctx_t *ctx, int fill_pct)
+{
+    // Calibrar la cantidad de iteraciones para que cada corrida dure ~BENCH_TARGET_NS
+    uint64_t iters = 1;
+    for (;;)
+    {
+        uint64_t start = bench_now_ns();
+        kernel(ctx, iters);
+        uint64_t elapsed = bench_now_ns() - start;
+        if (elapsed >= BENCH_TARGET_NS / 10 || iters >= (1ull << 30))
+        {
+            iters = elapsed > 0 ? iters * BENCH_TARGET_NS / elapsed : iters;
+            break;
+        }
+        iters *= 10;
+    }
+    if (iters < 1)
+        iters = 1;
+
+    uint64_t counters[BENCH_PERF_EVENTS] = {0};
+    bench_stats_reset(&stats);
+    for (int run = 0; run < BENCH_RUNS; ++run)
+    {
+        uint64_t values[BENCH_PERF_EVENTS];
+        bench_perf_start(&perf);
+        uint64_t start = bench_now_ns();
+        kernel(ctx, iters);
+        uint64_t elapsed = bench_now_ns() - start;
+        bench_perf_stop(&perf, values);
+        bench_stats_add(&stats, (double)elapsed / iters);
+        for (int e = 0; e < BENCH_PERF_EVENTS; ++e)
+            counters[e] += values[e];
+    }
+
+    char board[32];
+    snprintf(board, sizeof(board), "%ux%u", ctx->state->board_width, ctx->state->board_height);
+    printf("%-24s %-11s %3d%%  %12.1f  %9.1f  %12.1f",
+           name, board, fill_pct, bench_stats_mean(&stats), bench_stats_stddev(&stats),
+           bench_stats_percentile(&stats, 0));
+    if (perf.enabled)
+    {
+        for (int e = 0; e < BENCH_PERF_EVENTS; ++e)
+            printf("  %10.1f", (double)counters[e] / ((double)iters * BENCH_RUNS));
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    bool use_counters = false;
+    bool quick = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "cq")) != -1)
+    {
+        switch (opt)
+        {
+        case 'c':
+            use_counters = true;
+            break;
+        case 'q':
+            quick = true;
+            break;
+        default:
+            fprintf(stderr, "Uso: %s [-c] [-q]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (use_counters && bench_perf_open(&perf) != 0)
+        fprintf(stderr, "Advertencia: contadores de hardware no disponibles, se mide sólo el tiempo\n");
+    if (bench_stats_init(&stats, BENCH_RUNS) != 0)
+        return EXIT_FAILURE;
+
+    static const unsigned short sizes[][2] = {{10, 10}, {100, 100}, {1000, 1000}, {2000, 2000}};
+    static const int fills[] = {0, 50, 90};
+    int num_sizes = quick ? 2 : (int)(sizeof(sizes) / sizeof(sizes[0]));
+
+    // Con BOARD_STATS_KERNEL=scalar|sse2|avx2 se comparan las implementaciones de board_stats.c
+    char board_stats_name[32];
+    snprintf(board_stats_name, sizeof(board_stats_name), "board_stats (%s)", board_stats_kernel_name());
+
+    printf("%-24s %-11s %4s  %12s  %9s  %12s", "kernel", "board", "fill", "ns/op", "stddev", "min");
+    if (perf.enabled)
+        for (int e = 0; e < BENCH_PERF_EVENTS; ++e)
+            printf("  %10s", bench_perf_names[e]);
+    printf("\n");
+
+    for (int s = 0; s < num_sizes; ++s)
+    {
+        for (size_t f = 0; f < sizeof(fills) / sizeof(fills[0]); ++f)
+        {
+            static bench_ctx_t ctx;
+            ctx.state = make_board(sizes[s][0], sizes[s][1], fills[f]);
+            fill_random_tables(&ctx);
+
+            run_bench("process_player_move", kernel_process_player_move, &ctx, fills[f]);
+            run_bench("update_lock_status", kernel_update_lock_status, &ctx, fills[f]);
+            run_bench(board_stats_name, kernel_board_stats, &ctx, fills[f]);
+            if (f == 0)
+            {
+                // No dependen del nivel de ocupación
+                run_bench("all_players_blocked", kernel_all_players_blocked, &ctx, fills[f]);
+                run_bench("compute_winner", kernel_compute_winner, &ctx, fills[f]);
+                run_bench("initialize_game_state", kernel_initialize_game_state, &ctx, fills[f]);
+            }
+            free(ctx.state);
+        }
+    }
+
+    bench_stats_free(&stats);
+    // Sin -c los descriptores nunca se abrieron (valen 0: cerrarlos cerraría stdin)
+    if (perf.enabled)
+        bench_perf_close(&perf);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+#include "bench_utils.h"
+#include "clock_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+const char *const bench_perf_names[BENCH_PERF_EVENTS] = {"cycles", "instr", "cache-miss", "br-miss"};
+
+uint64_t bench_now_ns(void) {
+    return monotonic_ns();
+}
+
+int bench_stats_init(bench_stats_t *stats, size_t capacity) {
+    stats->samples = malloc(capacity * sizeof(double));
+    stats->count = 0;
+    stats->capacity = capacity;
+    if (stats->samples == NULL) {
+        perror("malloc (bench_stats)");
+        return -1;
+    }
+    return 0;
+}
+
+void bench_stats_free(bench_stats_t *stats) {
+    free(stats->samples);
+    stats->samples = NULL;
+    stats->count = stats->capacity = 0;
+}
+
+void bench_stats_reset(bench_stats_t *stats) {
+    stats->count = 0;
+}
+
+void bench_stats_add(bench_stats_t *stats, double sample) {
+    if (stats->count < stats->capacity) {
+        stats->samples[stats->count++] = sample;
+    }
+}
+
+double bench_stats_mean(const bench_stats_t *stats) {
+    if (stats->count == 0)
+        return 0.0;
+    double sum = 0.0;
+    for (size_t i = 0; i < stats->count; ++i)
+        sum += stats->samples[i];
+    return sum / stats->count;
+}
+
+double bench_stats_stddev(const bench_stats_t *stats) {
+    if (stats->count < 2)
+        return 0.0;
+    double mean = bench_stats_mean(stats);
+    double acc = 0.0;
+    for (size_t i = 0; i < stats->count; ++i)
+        acc += (stats->samples[i] - mean) * (stats->samples[i] - mean);
+    return sqrt(acc / (stats->count - 1));
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+double bench_stats_percentile(bench_stats_t *stats, double p) {
+    if (stats->count == 0)
+        return 0.0;
+    qsort(stats->samples, stats->count, sizeof(double), compare_double);
+    size_t idx = (size_t)(p / 100.0 * (stats->count - 1) + 0.5);
+    return stats->samples[idx < stats->count ? idx : stats->count - 1];
+}
+
+int bench_perf_open(bench_perf_t *perf) {
+    static const uint64_t configs[BENCH_PERF_EVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+    perf->enabled = false;
+    for (int i = 0; i < BENCH_PERF_EVENTS; ++i)
+        perf->fds[i] = -1;
+
+    for (int i = 0; i < BENCH_PERF_EVENTS; ++i) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        perf->fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (perf->fds[i] == -1) {
+            perror("perf_event_open");
+            bench_perf_close(perf);
+            return -1;
+        }
+    }
+    perf->enabled = true;
+    return 0;
+}
+
+void bench_perf_close(bench_perf_t *perf) {
+    for (int i = 0; i < BENCH_PERF_EVENTS; ++i) {
+        if (perf->fds[i] >= 0)
+            close(perf->fds[i]);
+        perf->fds[i] = -1;
+    }
+    perf->enabled = false;
+}
+
+void bench_perf_start(bench_perf_t *perf) {
+    if (!perf->enabled)
+        return;
+    for (int i = 0; i < BENCH_PERF_EVENTS; ++i) {
+        ioctl(perf->fds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(perf->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void bench_perf_stop(bench_perf_t *perf, uint64_t values[BENCH_PERF_EVENTS]) {
+    for (int i = 0; i < BENCH_PERF_EVENTS; ++i) {
+        values[i] = 0;
+        if (!perf->enabled)
+            continue;
+        ioctl(perf->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        if (read(perf->fds[i], &values[i], sizeof(uint64_t)) != sizeof(uint64_t))
+            values[i] = 0;
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef BENCH_UTILS_H
+#define BENCH_UTILS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Utilidades comunes de los benchmarks (make microbench, make ipcbench)
+
+#define BENCH_PERF_EVENTS 4 // ciclos, instrucciones, fallos de caché, fallos de predicción de saltos
+
+// Muestras de una medición (ns/op o latencias en ns)
+typedef struct
+{
+    double *samples;
+    size_t count;
+    size_t capacity;
+} bench_stats_t;
+
+// Contadores de hardware vía perf_event_open (opcionales: si no hay permisos quedan deshabilitados)
+typedef struct
+{
+    int fds[BENCH_PERF_EVENTS];
+    bool enabled;
+} bench_perf_t;
+
+uint64_t bench_now_ns(void);
+
+int bench_stats_init(bench_stats_t *stats, size_t capacity);
+void bench_stats_free(bench_stats_t *stats);
+void bench_stats_reset(bench_stats_t *stats);
+void bench_stats_add(bench_stats_t *stats, double sample);
+double bench_stats_mean(const bench_stats_t *stats);
+double bench_stats_stddev(const bench_stats_t *stats);
+// Ordena las muestras; p entre 0 y 100
+double bench_stats_percentile(bench_stats_t *stats, double p);
+
+int bench_perf_open(bench_perf_t *perf);
+void bench_perf_close(bench_perf_t *perf);
+void bench_perf_start(bench_perf_t *perf);
+// Detiene los contadores y devuelve los valores acumulados desde bench_perf_start
+void bench_perf_stop(bench_perf_t *perf, uint64_t values[BENCH_PERF_EVENTS]);
+extern const char *const bench_perf_names[BENCH_PERF_EVENTS];
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef BOARD_ACCESS_H
+#define BOARD_ACCESS_H
+
+#include "shared_memory.h"
+#include <limits.h>
+#include <stddef.h>
+
+/*
+ * Acceso al tablero de game_state_t independiente de su formato. Master, jugadores y vista deben indexar
+ * el tablero sólo a través de estas funciones.
+ *
+ * - Formato de la especificación: fila-0, fila-1, ..., fila-n-1, con board_width celdas por fila.
+ * - Formato con borde (make PADDED_BOARD=1): cada fila ocupa board_stride() celdas (potencia de dos) y el
+ *   tablero está rodeado por un borde de una celda con BOARD_SENTINEL. Como el centinela nunca es una
+ *   recompensa (> 0), moverse fuera del tablero es simplemente moverse a una celda no libre y el acceso a
+ *   los 8 vecinos no necesita chequeos de límites.
+ */
+
+#define BOARD_SENTINEL INT_MIN
+
+#ifdef PADDED_BOARD_LAYOUT
+#define BOARD_NEEDS_BOUNDS_CHECK 0
+#define BOARD_BORDER 1
+#else
+#define BOARD_NEEDS_BOUNDS_CHECK 1
+#define BOARD_BORDER 0
+#endif
+
+// Cantidad de celdas entre el comienzo de una fila y el de la siguiente
+static inline size_t board_stride(unsigned short width)
+{
+#ifdef PADDED_BOARD_LAYOUT
+    // Menor potencia de dos >= width + 2, sin bucle: width + 1 >= 1, así que clz está definido
+    return (size_t)1 << (32 - __builtin_clz((unsigned int)width + 1));
+#else
+    return width;
+#endif
+}
+
+// Cantidad de celdas que ocupa el tablero en memoria (incluyendo borde y relleno)
+static inline size_t board_alloc_cells(unsigned short width, unsigned short height)
+{
+    return board_stride(width) * ((size_t)height + 2 * BOARD_BORDER);
+}
+
+// Índice de (x, y) con el stride ya calculado, para los bucles que indexan varias celdas
+static inline size_t board_index_stride(size_t stride, int x, int y)
+{
+    return ((size_t)(y + BOARD_BORDER)) * stride + (size_t)(x + BOARD_BORDER);
+}
+
+static inline size_t board_index(const game_state_t *state, int x, int y)
+{
+    return board_index_stride(board_stride(state->board_width), x, y);
+}
+
+static inline bool board_in_bounds(const game_state_t *state, int x, int y)
+{
+    return x >= 0 && x < state->board_width && y >= 0 && y < state->board_height;
+}
+
+// Precalcula el desplazamiento lineal de cada una de las 8 direcciones
+static inline void board_neighbor_offsets(const game_state_t *state, const int dir_offsets[8][2], ptrdiff_t offsets[8])
+{
+    ptrdiff_t stride = (ptrdiff_t)board_stride(state->board_width);
+    for (int d = 0; d < 8; ++d)
+        offsets[d] = dir_offsets[d][1] * stride + dir_offsets[d][0];
+}
+
+// Rellena el borde y el relleno de cada fila con BOARD_SENTINEL (no hace nada en el formato de la especificación)
+static inline void board_init_border(game_state_t *state)
+{
+#ifdef PADDED_BOARD_LAYOUT
+    size_t stride = board_stride(state->board_width);
+    size_t rows = (size_t)state->board_height + 2;
+    for (size_t r = 0; r < rows; ++r)
+    {
+        int *row = &state->board[r * stride];
+        bool border_row = (r == 0 || r == rows - 1);
+        for (size_t c = 0; c < stride; ++c)
+        {
+            if (border_row || c == 0 || c > state->board_width)
+                row[c] = BOARD_SENTINEL;
+        }
+    }
+#else
+    (void)state;
+#endif
+}
+
+#define BOARD_CELL(state, x, y) ((state)->board[board_index((state), (x), (y))])
+
+#endif
@@ -0,0 +1,160 @@
+#include "board_file.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+size_t board_file_size(unsigned short width, unsigned short height) {
+    return sizeof(board_file_header_t) + (size_t)width * height * sizeof(int);
+}
+
+static void board_file_reset(board_file_t *bf) {
+    bf->fd = -1;
+    bf->map = NULL;
+    bf->map_size = 0;
+    bf->header = NULL;
+    bf->cells = NULL;
+}
+
+int board_file_open(const char *path, board_file_t *bf) {
+    board_file_reset(bf);
+
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        fprintf(stderr, "Error: No se puede abrir el tablero '%s': %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        perror("fstat (tablero)");
+        close(fd);
+        return -1;
+    }
+    if ((size_t)st.st_size < sizeof(board_file_header_t)) {
+        fprintf(stderr, "Error: '%s' no es un archivo de tablero válido\n", path);
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        perror("mmap (tablero)");
+        close(fd);
+        return -1;
+    }
+
+    const board_file_header_t *header = map;
+    if (memcmp(header->magic, BOARD_FILE_MAGIC, sizeof(BOARD_FILE_MAGIC)) != 0 ||
+        header->version != BOARD_FILE_VERSION ||
+        header->header_size != sizeof(board_file_header_t) ||
+        header->cell_size != sizeof(int)) {
+        fprintf(stderr, "Error: '%s' no es un archivo de tablero válido (versión %u)\n", path, BOARD_FILE_VERSION);
+        munmap(map, st.st_size);
+        close(fd);
+        return -1;
+    }
+    if ((size_t)st.st_size != board_file_size(header->board_width, header->board_height)) {
+        fprintf(stderr, "Error: El tamaño de '%s' no coincide con un tablero de %ux%u\n",
+                path, header->board_width, header->board_height);
+        munmap(map, st.st_size);
+        close(fd);
+        return -1;
+    }
+
+    // El master lo recorre una única vez de principio a fin
+    madvise(map, st.st_size, MADV_SEQUENTIAL | MADV_WILLNEED);
+
+    const int *cells = (const int *)((const char *)map + header->header_size);
+    size_t count = (size_t)header->board_width * header->board_height;
+    for (size_t i = 0; i < count; ++i) {
+        if (cells[i] < 1 || cells[i] > 9) {
+            fprintf(stderr, "Error: '%s' tiene un valor inválido (%d) en la celda (%zu,%zu)\n",
+                    path, cells[i], i % header->board_width, i / header->board_width);
+            munmap(map, st.st_size);
+            close(fd);
+            return -1;
+        }
+    }
+
+    bf->fd = fd;
+    bf->map = map;
+    bf->map_size = st.st_size;
+    bf->header = header;
+    bf->cells = (int *)((char *)map + header->header_size);
+    return 0;
+}
+
+void board_start_position(int i, int num_players, unsigned short width, unsigned short height, unsigned short *x, unsigned short *y) {
+    // ceil(sqrt(num_players)) sin punto flotante
+    int grid_rows = 1;
+    while (grid_rows * grid_rows < num_players) {
+        grid_rows++;
+    }
+    int grid_cols = (num_players + grid_rows - 1) / grid_rows;
+    if (grid_cols < 1) {
+        grid_cols = 1;
+    }
+
+    int row = i / grid_cols;
+    int col = i % grid_cols;
+    unsigned short px = (unsigned short)(((col + 1) * (long)width) / (grid_cols + 1));
+    unsigned short py = (unsigned short)(((row + 1) * (long)height) / (grid_rows + 1));
+    *x = px < width ? px : width - 1;
+    *y = py < height ? py : height - 1;
+}
+
+int board_file_create(const char *path, unsigned short width, unsigned short height, unsigned int seed, board_file_t *bf) {
+    board_file_reset(bf);
+
+    size_t size = board_file_size(width, height);
+    int fd = open(path, O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (fd == -1) {
+        fprintf(stderr, "Error: No se puede crear el tablero '%s': %s\n", path, strerror(errno));
+        return -1;
+    }
+    if (ftruncate(fd, size) == -1) {
+        perror("ftruncate (tablero)");
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        perror("mmap (tablero)");
+        close(fd);
+        return -1;
+    }
+
+    board_file_header_t *header = map;
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, BOARD_FILE_MAGIC, sizeof(BOARD_FILE_MAGIC));
+    header->version = BOARD_FILE_VERSION;
+    header->header_size = sizeof(board_file_header_t);
+    header->board_width = width;
+    header->board_height = height;
+    header->seed = seed;
+    header->cell_size = sizeof(int);
+
+    bf->fd = fd;
+    bf->map = map;
+    bf->map_size = size;
+    bf->header = header;
+    bf->cells = (int *)((char *)map + header->header_size);
+    return 0;
+}
+
+void board_file_close(board_file_t *bf) {
+    if (bf->map != NULL) {
+        if (munmap(bf->map, bf->map_size) == -1) {
+            perror("munmap (tablero)");
+        }
+    }
+    if (bf->fd >= 0) {
+        close(bf->fd);
+    }
+    board_file_reset(bf);
+}
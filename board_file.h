@@ -0,0 +1,57 @@
+#ifndef BOARD_FILE_H
+#define BOARD_FILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Formato de archivo de tablero: una cabecera fija seguida de las celdas
+ * crudas (int, fila-0, fila-1, ..., fila-n-1), exactamente como se guardan en
+ * game_state_t::board. Así el master puede mapear el archivo y copiarlo al
+ * segmento /game_state sin ningún tipo de conversión.
+ *
+ * Sólo contiene recompensas (1 a 9): las posiciones iniciales las marca el
+ * master al cargarlo, y board_file_open rechaza cualquier otro valor.
+ */
+#define BOARD_FILE_MAGIC "CCBOARD"
+#define BOARD_FILE_VERSION 1
+
+typedef struct
+{
+    char magic[8];         // "CCBOARD\0"
+    uint32_t version;      // BOARD_FILE_VERSION
+    uint32_t header_size;  // sizeof(board_file_header_t), las celdas empiezan acá
+    uint16_t board_width;  // Ancho del tablero
+    uint16_t board_height; // Alto del tablero
+    uint32_t seed;         // Semilla con la que se generó (0 si es un mapa curado)
+    uint32_t cell_size;    // sizeof(int) de quien escribió el archivo
+    uint32_t reserved[3];
+} board_file_header_t;
+
+typedef struct
+{
+    int fd;
+    void *map;                         // Mapeo completo del archivo
+    size_t map_size;
+    const board_file_header_t *header;
+    int *cells;                        // Celdas del tablero dentro del mapeo
+} board_file_t;
+
+// Abre y valida un archivo de tablero, mapeándolo en modo solo lectura. Retorna 0 o -1.
+int board_file_open(const char *path, board_file_t *bf);
+
+// Crea un archivo de tablero vacío de width x height y lo mapea para escritura. Retorna 0 o -1.
+int board_file_create(const char *path, unsigned short width, unsigned short height, unsigned int seed, board_file_t *bf);
+
+void board_file_close(board_file_t *bf);
+
+size_t board_file_size(unsigned short width, unsigned short height);
+
+/**
+ * Posición inicial del jugador i cuando juegan num_players: los jugadores se reparten en una grilla
+ * uniforme sobre el tablero. La usan el master y board_gen, que deja esas celdas fuera de la secuencia
+ * de rand() igual que initialize_game_state.
+ */
+void board_start_position(int i, int num_players, unsigned short width, unsigned short height, unsigned short *x, unsigned short *y);
+
+#endif
@@ -0,0 +1,96 @@
+#include "board_file.h"
+#include "shared_memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <time.h>
+
+/*
+ * Genera un archivo de tablero a partir de una semilla, para luego cargarlo
+ * con `master -b archivo`. Las recompensas se generan con la misma regla que
+ * initialize_game_state (rand() % 9 + 1 por celda, fila por fila), que no
+ * llama a rand() en las posiciones iniciales de los jugadores. Con -n igual a
+ * la cantidad de jugadores, `board_gen -s N` reproduce el tablero de
+ * `master -s N`; sin -n (o con otra cantidad) la secuencia es distinta.
+ * En las posiciones iniciales se guarda un 1, que el master reemplaza al cargar.
+ */
+
+static void print_usage(const char *progname)
+{
+    fprintf(stderr, "Uso: %s [-w ancho] [-h alto] [-s semilla] [-n jugadores] -o archivo\n", progname);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned short width = 10, height = 10;
+    unsigned int seed = (unsigned int)time(NULL);
+    int num_players = 0;
+    const char *out_path = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "w:h:s:n:o:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'w':
+            width = (unsigned short)atoi(optarg);
+            break;
+        case 'h':
+            height = (unsigned short)atoi(optarg);
+            break;
+        case 's':
+            seed = (unsigned int)atoi(optarg);
+            break;
+        case 'n':
+            num_players = atoi(optarg);
+            break;
+        case 'o':
+            out_path = optarg;
+            break;
+        default:
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (out_path == NULL)
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (width < 10 || height < 10)
+    {
+        fprintf(stderr, "Error: Las dimensiones mínimas son 10x10\n");
+        return EXIT_FAILURE;
+    }
+    if (num_players < 0 || num_players > MAX_PLAYERS)
+    {
+        fprintf(stderr, "Error: La cantidad de jugadores debe estar entre 0 y %d\n", MAX_PLAYERS);
+        return EXIT_FAILURE;
+    }
+
+    board_file_t bf;
+    if (board_file_create(out_path, width, height, seed, &bf) != 0)
+        return EXIT_FAILURE;
+
+    unsigned short start_x[MAX_PLAYERS], start_y[MAX_PLAYERS];
+    for (int k = 0; k < num_players; ++k)
+        board_start_position(k, num_players, width, height, &start_x[k], &start_y[k]);
+
+    srand(seed);
+    for (unsigned short y = 0; y < height; ++y)
+    {
+        for (unsigned short x = 0; x < width; ++x)
+        {
+            bool start = false;
+            for (int k = 0; k < num_players && !start; ++k)
+                start = start_x[k] == x && start_y[k] == y;
+            bf.cells[(size_t)y * width + x] = start ? 1 : (rand() % 9) + 1;
+        }
+    }
+
+    board_file_close(&bf);
+    printf("Tablero %ux%u (semilla %u) guardado en %s\n", width, height, seed, out_path);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,229 @@
+#include "board_stats.h"
+#include "board_access.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define BOARD_STATS_X86 1
+#else
+#define BOARD_STATS_X86 0
+#endif
+
+/*
+ * Cada kernel recorre rows filas de width celdas, separadas por stride celdas: con el formato compacto el
+ * tablero entero es una sola fila de ancho * alto celdas, y con PADDED_BOARD_LAYOUT se salta el borde de
+ * cada fila. Las celdas libres valen 1..9 y las del jugador k valen -k. Los kernels vectoriales empaquetan
+ * las celdas a 8 bits con saturación (el centinela INT_MIN queda en -128 y no coincide con nada) y cuentan
+ * con una comparación "> 0" y una comparación por igualdad por jugador. El orden de las celdas se pierde
+ * al empaquetar, pero para contar no importa. Las claves de los jugadores se arman una vez por llamada y
+ * los contadores de 8 bits se vuelcan con _mm*_sad_epu8 cada BYTE_FLUSH_ITERS vectores, sin importar en
+ * qué fila estén.
+ */
+typedef void (*span_kernel_fn)(const int *cells, size_t stride, size_t width, size_t rows, unsigned int owners,
+                               board_stats_t *stats);
+
+#define BYTE_FLUSH_ITERS 255
+
+// Siempre en línea: dentro de span_avx2 se compila con codificación VEX. Llamada, GCC la vectoriza con SSE
+// y, con la mitad alta de los registros ymm ocupada, cada fila pagaría la transición SSE/AVX.
+static inline __attribute__((always_inline)) void count_scalar(const int *row, size_t n, unsigned int owners,
+                                                               board_stats_t *stats) {
+    for (size_t i = 0; i < n; ++i) {
+        int value = row[i];
+        if (value > 0) {
+            stats->free_cells++;
+            stats->remaining_reward += (unsigned int)value;
+        } else if (value > -(int)owners) {
+            stats->owned[-value]++;
+        }
+    }
+}
+
+static void span_scalar(const int *cells, size_t stride, size_t width, size_t rows, unsigned int owners,
+                        board_stats_t *stats) {
+    for (size_t r = 0; r < rows; ++r) {
+        count_scalar(cells + r * stride, width, owners, stats);
+    }
+}
+
+#if BOARD_STATS_X86
+__attribute__((target("sse2")))
+static uint64_t sum_bytes_128(__m128i v) {
+    __m128i sums = _mm_sad_epu8(v, _mm_setzero_si128());
+    return (uint64_t)_mm_cvtsi128_si64(sums) + (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums));
+}
+
+__attribute__((target("sse2")))
+static void flush_sse2(__m128i *free_acc, __m128i *reward_acc, __m128i owned_acc[], unsigned int owners,
+                       board_stats_t *stats) {
+    stats->free_cells += sum_bytes_128(*free_acc);
+    stats->remaining_reward += (uint64_t)_mm_cvtsi128_si64(*reward_acc) +
+                               (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(*reward_acc, *reward_acc));
+    for (unsigned int k = 0; k < owners; ++k) {
+        stats->owned[k] += sum_bytes_128(owned_acc[k]);
+        owned_acc[k] = _mm_setzero_si128();
+    }
+    *free_acc = _mm_setzero_si128();
+    *reward_acc = _mm_setzero_si128();
+}
+
+__attribute__((target("sse2")))
+static void span_sse2(const int *cells, size_t stride, size_t width, size_t rows, unsigned int owners,
+                      board_stats_t *stats) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i owner_key[MAX_PLAYERS];
+    __m128i owned_acc[MAX_PLAYERS];
+    for (unsigned int k = 0; k < owners; ++k) {
+        owner_key[k] = _mm_set1_epi8((char)-(int)k);
+        owned_acc[k] = zero;
+    }
+    __m128i free_acc = zero, reward_acc = zero;
+    int iters = 0;
+
+    for (size_t r = 0; r < rows; ++r) {
+        const int *row = cells + r * stride;
+        size_t i = 0;
+        for (; i + 16 <= width; i += 16) {
+            const __m128i *src = (const __m128i *)(row + i);
+            __m128i lo = _mm_packs_epi32(_mm_loadu_si128(src), _mm_loadu_si128(src + 1));
+            __m128i hi = _mm_packs_epi32(_mm_loadu_si128(src + 2), _mm_loadu_si128(src + 3));
+            __m128i packed = _mm_packs_epi16(lo, hi);
+            __m128i is_free = _mm_cmpgt_epi8(packed, zero);
+            free_acc = _mm_sub_epi8(free_acc, is_free); // La máscara vale -1 en cada celda libre
+            reward_acc = _mm_add_epi64(reward_acc, _mm_sad_epu8(_mm_and_si128(packed, is_free), zero));
+            for (unsigned int k = 0; k < owners; ++k) {
+                owned_acc[k] = _mm_sub_epi8(owned_acc[k], _mm_cmpeq_epi8(packed, owner_key[k]));
+            }
+            if (++iters == BYTE_FLUSH_ITERS) {
+                flush_sse2(&free_acc, &reward_acc, owned_acc, owners, stats);
+                iters = 0;
+            }
+        }
+        count_scalar(row + i, width - i, owners, stats);
+    }
+    flush_sse2(&free_acc, &reward_acc, owned_acc, owners, stats);
+}
+
+__attribute__((target("avx2")))
+static uint64_t sum_epi64_256(__m256i v) {
+    __m128i sums = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return (uint64_t)_mm_cvtsi128_si64(sums) + (uint64_t)_mm_extract_epi64(sums, 1);
+}
+
+__attribute__((target("avx2")))
+static void flush_avx2(__m256i *free_acc, __m256i *reward_acc, __m256i owned_acc[], unsigned int owners,
+                       board_stats_t *stats) {
+    const __m256i zero = _mm256_setzero_si256();
+    stats->free_cells += sum_epi64_256(_mm256_sad_epu8(*free_acc, zero));
+    stats->remaining_reward += sum_epi64_256(*reward_acc);
+    for (unsigned int k = 0; k < owners; ++k) {
+        stats->owned[k] += sum_epi64_256(_mm256_sad_epu8(owned_acc[k], zero));
+        owned_acc[k] = zero;
+    }
+    *free_acc = zero;
+    *reward_acc = zero;
+}
+
+__attribute__((target("avx2")))
+static void span_avx2(const int *cells, size_t stride, size_t width, size_t rows, unsigned int owners,
+                      board_stats_t *stats) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i owner_key[MAX_PLAYERS];
+    __m256i owned_acc[MAX_PLAYERS];
+    for (unsigned int k = 0; k < owners; ++k) {
+        owner_key[k] = _mm256_set1_epi8((char)-(int)k);
+        owned_acc[k] = zero;
+    }
+    __m256i free_acc = zero, reward_acc = zero;
+    int iters = 0;
+
+    for (size_t r = 0; r < rows; ++r) {
+        const int *row = cells + r * stride;
+        size_t i = 0;
+        for (; i + 32 <= width; i += 32) {
+            const __m256i *src = (const __m256i *)(row + i);
+            __m256i lo = _mm256_packs_epi32(_mm256_loadu_si256(src), _mm256_loadu_si256(src + 1));
+            __m256i hi = _mm256_packs_epi32(_mm256_loadu_si256(src + 2), _mm256_loadu_si256(src + 3));
+            __m256i packed = _mm256_packs_epi16(lo, hi);
+            __m256i is_free = _mm256_cmpgt_epi8(packed, zero);
+            free_acc = _mm256_sub_epi8(free_acc, is_free);
+            reward_acc = _mm256_add_epi64(reward_acc, _mm256_sad_epu8(_mm256_and_si256(packed, is_free), zero));
+            for (unsigned int k = 0; k < owners; ++k) {
+                owned_acc[k] = _mm256_sub_epi8(owned_acc[k], _mm256_cmpeq_epi8(packed, owner_key[k]));
+            }
+            if (++iters == BYTE_FLUSH_ITERS) {
+                flush_avx2(&free_acc, &reward_acc, owned_acc, owners, stats);
+                iters = 0;
+            }
+        }
+        count_scalar(row + i, width - i, owners, stats);
+    }
+    flush_avx2(&free_acc, &reward_acc, owned_acc, owners, stats);
+    // GCC no siempre emite vzeroupper en funciones con target("avx2"): sin esto, el código SSE del que
+    // llama paga la transición de estado AVX
+    _mm256_zeroupper();
+}
+#endif
+
+typedef struct {
+    const char *name;
+    span_kernel_fn fn;
+    size_t lanes; // Celdas por vector: con filas más cortas no hay nada que vectorizar
+} kernel_entry_t;
+
+static kernel_entry_t selected = {"scalar", span_scalar, 1};
+static pthread_once_t selected_once = PTHREAD_ONCE_INIT;
+
+static void select_kernel(void) {
+    // Candidatos en orden de preferencia; el último siempre está disponible
+    kernel_entry_t candidates[3];
+    int count = 0;
+#if BOARD_STATS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        candidates[count++] = (kernel_entry_t){"avx2", span_avx2, 32};
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        candidates[count++] = (kernel_entry_t){"sse2", span_sse2, 16};
+    }
+#endif
+    candidates[count++] = (kernel_entry_t){"scalar", span_scalar, 1};
+
+    selected = candidates[0];
+    const char *forced = getenv("BOARD_STATS_KERNEL");
+    if (forced == NULL || *forced == '\0') {
+        return;
+    }
+    for (int c = 0; c < count; ++c) {
+        if (strcmp(forced, candidates[c].name) == 0) {
+            selected = candidates[c];
+            return;
+        }
+    }
+    fprintf(stderr, "Advertencia: BOARD_STATS_KERNEL=%s no disponible, se usa %s\n", forced, selected.name);
+}
+
+void board_stats_compute(const game_state_t *state, board_stats_t *stats) {
+    pthread_once(&selected_once, select_kernel);
+    memset(stats, 0, sizeof(*stats));
+
+    unsigned int owners = state->player_count < MAX_PLAYERS ? state->player_count : MAX_PLAYERS;
+    size_t stride = board_stride(state->board_width);
+    size_t width = state->board_width, rows = state->board_height;
+    if (stride == width) {
+        // Formato compacto: las filas son contiguas y el tablero se recorre como una sola
+        width *= rows;
+        rows = 1;
+    }
+    span_kernel_fn fn = width < selected.lanes ? span_scalar : selected.fn;
+    fn(&BOARD_CELL(state, 0, 0), stride, width, rows, owners, stats);
+}
+
+const char *board_stats_kernel_name(void) {
+    pthread_once(&selected_once, select_kernel);
+    return selected.name;
+}
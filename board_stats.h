@@ -0,0 +1,26 @@
+#ifndef BOARD_STATS_H
+#define BOARD_STATS_H
+
+#include "shared_memory.h"
+
+/*
+ * Estadísticas del tablero en una sola pasada: celdas de cada jugador, celdas libres y recompensa restante.
+ * El recorrido usa AVX2 o SSE2 cuando la CPU los tiene (se elige en tiempo de ejecución, una sola vez) y
+ * un bucle escalar en otro caso. La variable de entorno BOARD_STATS_KERNEL=avx2|sse2|scalar fuerza una
+ * implementación, para comparar resultados y tiempos.
+ */
+
+typedef struct
+{
+    unsigned long owned[MAX_PLAYERS]; // Celdas capturadas por cada jugador (incluida la inicial)
+    unsigned long free_cells;         // Celdas con recompensa
+    unsigned long long remaining_reward;
+} board_stats_t;
+
+// Recorre el tablero y completa stats. Quien lo llama debe tener el tablero en un estado consistente.
+void board_stats_compute(const game_state_t *state, board_stats_t *stats);
+
+// Nombre de la implementación elegida ("avx2", "sse2" o "scalar")
+const char *board_stats_kernel_name(void);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef CHANGE_LOG_H
+#define CHANGE_LOG_H
+
+#include <stdint.h>
+
+/*
+ * Registro circular de cambios del tablero que publica el master en /game_ext. Cada celda que cambia
+ * agrega una entrada (índice lógico y * ancho + x, valor nuevo, número de secuencia). Un lector que
+ * recuerda la última secuencia aplicada puede actualizar su copia del tablero en O(cambios); si quedó
+ * más de CHANGE_LOG_CAPACITY cambios atrás, debe volver a copiar el tablero completo.
+ *
+ * El master escribe dentro de writer_enter/writer_exit y los lectores leen dentro de
+ * reader_enter/reader_exit, por lo que no hace falta otra sincronización.
+ */
+
+#define CHANGE_LOG_CAPACITY 4096 // Potencia de dos
+
+typedef struct
+{
+    uint64_t seq;  // Secuencia del cambio (la entrada es válida si seq coincide con la esperada)
+    uint32_t cell; // Índice lógico de la celda: y * board_width + x
+    int32_t value; // Valor nuevo de la celda
+} change_log_entry_t;
+
+typedef struct
+{
+    uint64_t head; // Secuencia del próximo cambio; hay cambios publicados de 0 a head - 1
+    change_log_entry_t entries[CHANGE_LOG_CAPACITY];
+} change_log_t;
+
+static inline void change_log_append(change_log_t *log, uint32_t cell, int32_t value)
+{
+    change_log_entry_t *entry = &log->entries[log->head & (CHANGE_LOG_CAPACITY - 1)];
+    entry->seq = log->head;
+    entry->cell = cell;
+    entry->value = value;
+    log->head++;
+}
+
+// Entrada con secuencia seq, o NULL si ya fue sobreescrita o todavía no existe
+static inline const change_log_entry_t *change_log_get(const change_log_t *log, uint64_t seq)
+{
+    const change_log_entry_t *entry = &log->entries[seq & (CHANGE_LOG_CAPACITY - 1)];
+    return (seq < log->head && entry->seq == seq) ? entry : 0;
+}
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef CLOCK_UTILS_H
+#define CLOCK_UTILS_H
+
+#include <stdint.h>
+#include <time.h>
+
+/*
+ * Reloj monótono para medir intervalos y plazos (CLOCK_MONOTONIC: no salta con los cambios de hora). Lo
+ * usan el master, las herramientas y los benchmarks.
+ */
+
+static inline uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t monotonic_ms(void)
+{
+    return monotonic_ns() / 1000000ull;
+}
+
+#endif
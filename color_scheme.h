@@ -0,0 +1,70 @@
+#ifndef COLOR_SCHEME_H
+#define COLOR_SCHEME_H
+
+/*
+ * Esquema de colores de la vista, compartido con el exportador de frames (render.c) para que los videos
+ * se vean igual que la terminal. Los colores son los 8 de ANSI, numerados igual que COLOR_BLACK..COLOR_WHITE
+ * de curses, así este header no depende de ncurses.
+ */
+
+enum
+{
+    ANSI_BLACK,
+    ANSI_RED,
+    ANSI_GREEN,
+    ANSI_YELLOW,
+    ANSI_BLUE,
+    ANSI_MAGENTA,
+    ANSI_CYAN,
+    ANSI_WHITE
+};
+
+// Pares de colores (numerados desde 1, en el orden de color_scheme)
+#define COLOR_BOARD_BG 1
+#define COLOR_PLAYER1 2
+#define COLOR_PLAYER2 3
+#define COLOR_PLAYER3 4
+#define COLOR_PLAYER4 5
+#define COLOR_SCORE 6
+#define COLOR_CAPTURED 7
+
+#define PLAYER_COLOR_COUNT 4 // Los jugadores repiten colores cada PLAYER_COLOR_COUNT
+
+typedef struct
+{
+    short pair;
+    short fg, bg;
+} color_pair_def_t;
+
+static const color_pair_def_t color_scheme[] = {
+    {COLOR_BOARD_BG, ANSI_BLACK, ANSI_GREEN},
+    {COLOR_PLAYER1, ANSI_BLACK, ANSI_RED},
+    {COLOR_PLAYER2, ANSI_BLACK, ANSI_BLUE},
+    {COLOR_PLAYER3, ANSI_BLACK, ANSI_YELLOW},
+    {COLOR_PLAYER4, ANSI_BLACK, ANSI_MAGENTA},
+    {COLOR_SCORE, ANSI_WHITE, ANSI_BLACK},
+    {COLOR_CAPTURED, ANSI_BLACK, ANSI_WHITE}
+};
+
+#define COLOR_SCHEME_SIZE (sizeof(color_scheme) / sizeof(color_scheme[0]))
+
+static inline int player_color_pair(unsigned int player)
+{
+    return COLOR_PLAYER1 + (int)(player % PLAYER_COLOR_COUNT);
+}
+
+static inline const color_pair_def_t *color_pair_def(int pair)
+{
+    return &color_scheme[pair - 1];
+}
+
+// RGB de un color ANSI con la paleta por defecto de xterm
+static inline const unsigned char *ansi_rgb(int color)
+{
+    static const unsigned char palette[8][3] = {
+        {0, 0, 0}, {205, 0, 0}, {0, 205, 0}, {205, 205, 0}, {0, 0, 238}, {205, 0, 205}, {0, 205, 205}, {229, 229, 229}
+    };
+    return palette[color & 7];
+}
+
+#endif
@@ -0,0 +1,334 @@
+#include "control.h"
+#include "board_access.h"
+#include "spectator_server.h"
+#include "unix_socket.h"
+#include "event_ring.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#define CONTROL_REPLY_MAX 4096
+#define CONTROL_MAX_DELAY_MS 600000
+#define CONTROL_MAX_TIMEOUT_S 86400
+
+typedef struct {
+    char text[CONTROL_REPLY_MAX];
+    size_t len;
+} control_reply_t;
+
+static void reply_append(control_reply_t *reply, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+static void reply_append(control_reply_t *reply, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(reply->text + reply->len, sizeof(reply->text) - reply->len, format, args);
+    va_end(args);
+    if (n > 0) {
+        reply->len += (size_t)n;
+        if (reply->len >= sizeof(reply->text)) {
+            reply->len = sizeof(reply->text) - 1;
+        }
+    }
+}
+
+static long elapsed_ms(const struct timespec *since) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - since->tv_sec) * 1000L + (now.tv_nsec - since->tv_nsec) / 1000000L;
+}
+
+static int parse_bounded(const char *arg, long min, long max, unsigned int *value) {
+    if (arg == NULL) {
+        return -1;
+    }
+    char *end;
+    errno = 0;
+    long v = strtol(arg, &end, 10);
+    if (errno != 0 || end == arg || *end != '\0' || v < min || v > max) {
+        return -1;
+    }
+    *value = (unsigned int)v;
+    return 0;
+}
+
+static void command_stats(control_t *ctl, control_reply_t *reply) {
+    const game_state_t *state = ctl->state;
+    unsigned long valid = 0, invalid = 0;
+    for (unsigned int i = 0; i < state->player_count; ++i) {
+        valid += PLAYER_HOT(state, i)->valid_moves;
+        invalid += PLAYER_HOT(state, i)->invalid_moves;
+    }
+    reply_append(reply, "game %ux%u, %u players, elapsed %.1f s, %s, delay_ms %u, timeout_s %u\n",
+                 state->board_width, state->board_height, state->player_count, elapsed_ms(&ctl->started) / 1000.0,
+                 ctl->paused ? "paused" : "running", *ctl->delay_ms, *ctl->timeout_s);
+    reply_append(reply, "moves %lu valid, %lu invalid, events %llu, free cells %lu, board hash %016llx, commands %lu\n",
+                 valid, invalid, (unsigned long long)event_ring_head(&ctl->ext->events),
+                 (unsigned long)ctl->ext->free_cells, (unsigned long long)ctl->ext->board_hash, ctl->commands);
+    for (unsigned int i = 0; i < state->player_count; ++i) {
+        const player_hot_t *p = PLAYER_HOT(state, i);
+        reply_append(reply, "player %u %s: score %u, %u valid, %u invalid, at (%u,%u)%s\n", i,
+                     state->players[i].player_name, p->score, p->valid_moves, p->invalid_moves, p->pos_x, p->pos_y,
+                     p->is_blocked ? ", blocked" : "");
+    }
+}
+
+// Guarda el tablero actual como una grabación de un keyframe (spectator_proto.h), que conserva las celdas
+// capturadas y los jugadores; render -i la exporta. El master es el único que escribe el estado, así que
+// no hace falta el lock.
+static int command_snapshot(control_t *ctl, const char *path, control_reply_t *reply) {
+    const game_state_t *state = ctl->state;
+    if (path == NULL) {
+        return -1;
+    }
+    size_t cells = (size_t)state->board_width * state->board_height;
+    size_t size = sizeof(spectator_frame_t) + sizeof(spectator_keyframe_t) +
+                  state->player_count * sizeof(spectator_player_t) + cells;
+    char *frame = malloc(size);
+    if (frame == NULL) {
+        perror("malloc (snapshot)");
+        return -1;
+    }
+
+    spectator_frame_t header = {(uint32_t)size, SPECTATOR_KEYFRAME, {0}, event_ring_head(&ctl->ext->events)};
+    spectator_keyframe_t body = {state->board_width, state->board_height, (uint8_t)state->player_count, {0}};
+    char *p = frame;
+    memcpy(p, &header, sizeof(header));
+    p += sizeof(header);
+    memcpy(p, &body, sizeof(body));
+    p += sizeof(body);
+    for (unsigned int i = 0; i < state->player_count; ++i) {
+        spectator_player_from_state((spectator_player_t *)p, state, i);
+        p += sizeof(spectator_player_t);
+    }
+    for (unsigned short y = 0; y < state->board_height; ++y) {
+        for (unsigned short x = 0; x < state->board_width; ++x) {
+            *p++ = (char)(int8_t)BOARD_CELL(state, x, y);
+        }
+    }
+
+    FILE *out = fopen(path, "wb");
+    if (out == NULL) {
+        perror("fopen (snapshot)");
+        free(frame);
+        return -1;
+    }
+    size_t written = fwrite(frame, 1, size, out);
+    free(frame);
+    if (fclose(out) != 0 || written != size) {
+        perror("fwrite (snapshot)");
+        unlink(path);
+        return -1;
+    }
+    reply_append(reply, "snapshot %s (%ux%u, seed %u, board hash %016llx)\n", path, state->board_width,
+                 state->board_height, ctl->seed, (unsigned long long)ctl->ext->board_hash);
+    return 0;
+}
+
+// Ejecuta un comando. Retorna false si el cliente pidió cerrar la conexión.
+static bool execute_command(control_t *ctl, char *line, control_reply_t *reply) {
+    char *save;
+    char *command = strtok_r(line, " \t\r", &save);
+    char *arg = strtok_r(NULL, " \t\r", &save);
+    const char *error = NULL;
+
+    if (command == NULL) {
+        return true; // Línea vacía
+    }
+    ctl->commands++;
+    if (strcmp(command, "delay") == 0) {
+        if (parse_bounded(arg, 0, CONTROL_MAX_DELAY_MS, ctl->delay_ms) != 0) {
+            error = "delay expects milliseconds";
+        }
+    } else if (strcmp(command, "timeout") == 0) {
+        if (parse_bounded(arg, 1, CONTROL_MAX_TIMEOUT_S, ctl->timeout_s) != 0) {
+            error = "timeout expects seconds";
+        }
+    } else if (strcmp(command, "pause") == 0) {
+        ctl->paused = true;
+    } else if (strcmp(command, "resume") == 0) {
+        ctl->paused = false;
+    } else if (strcmp(command, "snapshot") == 0) {
+        if (command_snapshot(ctl, arg, reply) != 0) {
+            error = arg == NULL ? "snapshot expects a path" : "cannot write snapshot";
+        }
+    } else if (strcmp(command, "stats") == 0) {
+        command_stats(ctl, reply);
+    } else if (strcmp(command, "help") == 0) {
+        reply_append(reply, "delay MS | timeout S | pause | resume | snapshot PATH | stats | quit\n");
+    } else if (strcmp(command, "quit") == 0) {
+        return false;
+    } else {
+        error = "unknown command (try help)";
+    }
+
+    if (error != NULL) {
+        reply_append(reply, "error: %s\n", error);
+    } else {
+        reply_append(reply, "ok\n");
+    }
+    return true;
+}
+
+static void close_client(control_t *ctl, int c) {
+    close(ctl->clients[c].fd);
+    ctl->clients[c] = ctl->clients[--ctl->client_count];
+}
+
+// Las respuestas son cortas: si el cliente no las lee, se lo desconecta en lugar de frenar al master
+static bool send_reply(int fd, const control_reply_t *reply) {
+    size_t sent = 0;
+    while (sent < reply->len) {
+        ssize_t n = send(fd, reply->text + sent, reply->len - sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n == -1 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += (size_t)n;
+    }
+    return true;
+}
+
+// Lee del cliente y ejecuta sus líneas completas. Retorna false si hay que cerrarlo.
+static bool serve_client(control_t *ctl, control_client_t *client) {
+    ssize_t n = recv(client->fd, client->line + client->len, sizeof(client->line) - client->len, MSG_DONTWAIT);
+    if (n == 0 || (n == -1 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        return false;
+    }
+    if (n > 0) {
+        client->len += (size_t)n;
+    }
+
+    bool keep = true;
+    char *start = client->line;
+    char *newline;
+    while (keep && (newline = memchr(start, '\n', client->len - (size_t)(start - client->line))) != NULL) {
+        *newline = '\0';
+        control_reply_t reply = {.len = 0};
+        keep = execute_command(ctl, start, &reply) && send_reply(client->fd, &reply);
+        start = newline + 1;
+    }
+    client->len -= (size_t)(start - client->line);
+    memmove(client->line, start, client->len);
+
+    if (keep && client->len == sizeof(client->line)) {
+        control_reply_t reply = {.len = 0};
+        reply_append(&reply, "error: line too long\n");
+        send_reply(client->fd, &reply);
+        return false;
+    }
+    return keep;
+}
+
+int control_open(control_t *ctl, const char *path, unsigned int *delay_ms, unsigned int *timeout_s, game_state_t *state, game_ext_t *ext, unsigned int seed) {
+    memset(ctl, 0, sizeof(*ctl));
+    ctl->listen_fd = -1;
+    ctl->path = path;
+    ctl->delay_ms = delay_ms;
+    ctl->timeout_s = timeout_s;
+    ctl->state = state;
+    ctl->ext = ext;
+    ctl->seed = seed;
+    clock_gettime(CLOCK_MONOTONIC, &ctl->started);
+
+    int fd = unix_socket_listen(path, CONTROL_MAX_CLIENTS, true, "socket de control");
+    if (fd == -1) {
+        return -1;
+    }
+    ctl->listen_fd = fd;
+    return 0;
+}
+
+int control_fd_set(control_t *ctl, fd_set *readfds, int maxfd) {
+    if (ctl->listen_fd == -1) {
+        return maxfd;
+    }
+    FD_SET(ctl->listen_fd, readfds);
+    if (ctl->listen_fd > maxfd) {
+        maxfd = ctl->listen_fd;
+    }
+    for (int c = 0; c < ctl->client_count; ++c) {
+        FD_SET(ctl->clients[c].fd, readfds);
+        if (ctl->clients[c].fd > maxfd) {
+            maxfd = ctl->clients[c].fd;
+        }
+    }
+    return maxfd;
+}
+
+void control_handle(control_t *ctl, fd_set *readfds) {
+    if (ctl->listen_fd == -1) {
+        return;
+    }
+    // De atrás hacia adelante: close_client mueve el último cliente al lugar del que se cierra
+    for (int c = ctl->client_count - 1; c >= 0; --c) {
+        if (FD_ISSET(ctl->clients[c].fd, readfds) && !serve_client(ctl, &ctl->clients[c])) {
+            close_client(ctl, c);
+        }
+    }
+    if (FD_ISSET(ctl->listen_fd, readfds)) {
+        int fd;
+        while ((fd = accept4(ctl->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) != -1) {
+            if (ctl->client_count == CONTROL_MAX_CLIENTS) {
+                close(fd);
+                continue;
+            }
+            ctl->clients[ctl->client_count].fd = fd;
+            ctl->clients[ctl->client_count].len = 0;
+            ctl->client_count++;
+        }
+    }
+}
+
+bool control_wait(control_t *ctl, bool delay) {
+    if (ctl->listen_fd == -1) {
+        return false;
+    }
+    bool was_paused = false;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (;;) {
+        struct timeval tv;
+        struct timeval *timeout = NULL; // En pausa se espera sin plazo
+        if (ctl->paused) {
+            was_paused = true;
+        } else {
+            long remaining = delay ? (long)*ctl->delay_ms - elapsed_ms(&start) : 0;
+            if (remaining <= 0) {
+                return was_paused;
+            }
+            tv.tv_sec = remaining / 1000;
+            tv.tv_usec = (remaining % 1000) * 1000;
+            timeout = &tv;
+        }
+
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        int maxfd = control_fd_set(ctl, &readfds, -1);
+        int res = select(maxfd + 1, &readfds, NULL, NULL, timeout);
+        if (res > 0) {
+            control_handle(ctl, &readfds);
+        } else if (res < 0 && errno != EINTR) {
+            perror("select (control)");
+            ctl->paused = false;
+            return was_paused;
+        }
+    }
+}
+
+void control_close(control_t *ctl) {
+    if (ctl->listen_fd == -1) {
+        return;
+    }
+    while (ctl->client_count > 0) {
+        close_client(ctl, ctl->client_count - 1);
+    }
+    close(ctl->listen_fd);
+    unlink(ctl->path);
+    ctl->listen_fd = -1;
+}
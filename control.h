@@ -0,0 +1,87 @@
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include "shared_memory.h"
+#include <stdint.h>
+#include <time.h>
+#include <sys/select.h>
+
+/*
+ * Socket de control del master (master -C ruta). Lo atiende el propio bucle principal: los descriptores
+ * entran en el mismo select que los pipes de los jugadores, y durante la demora entre movimientos el
+ * master espera en el socket en lugar de dormir. Así se puede jugar con -d 0 y frenar la partida sólo
+ * mientras alguien la mira.
+ *
+ * Protocolo de texto, un comando por línea. Cada respuesta termina con una línea "ok" o "error: ...".
+ *   delay MS        cambia la demora entre movimientos
+ *   timeout S       cambia el tiempo límite sin movimientos válidos
+ *   pause, resume   detiene y reanuda la lectura de movimientos; al reanudar el tiempo límite empieza de cero
+ *   snapshot RUTA   guarda el tablero y los jugadores como una grabación de un keyframe (spectator_proto.h)
+ *   stats           contadores del master y estado de cada jugador
+ *   help, quit
+ */
+
+#define CONTROL_MAX_CLIENTS 8
+#define CONTROL_LINE_MAX 512
+
+typedef struct {
+    int fd;
+    char line[CONTROL_LINE_MAX];
+    size_t len;
+} control_client_t;
+
+typedef struct {
+    int listen_fd; // -1 si no hay socket de control
+    const char *path;
+    control_client_t clients[CONTROL_MAX_CLIENTS];
+    int client_count;
+    bool paused;
+
+    // Parámetros del master que se pueden cambiar en caliente
+    unsigned int *delay_ms;
+    unsigned int *timeout_s;
+
+    game_state_t *state;
+    game_ext_t *ext;
+    unsigned int seed;
+    unsigned long commands;
+    struct timespec started;
+} control_t;
+
+/**
+ * Crea el socket de control (con permisos sólo para el usuario).
+ *
+ * @param ctl Estructura a inicializar; con error queda deshabilitada (listen_fd = -1)
+ * @param path Ruta del socket (sólo se reemplaza un socket abandonado, ver unix_socket.h)
+ * @param delay_ms Demora entre movimientos del master
+ * @param timeout_s Tiempo límite del master
+ * @param state Estado del juego
+ * @param ext Extensiones (/game_ext), para los contadores
+ * @param seed Semilla de la partida, que se informa al guardar un snapshot
+ *
+ * @return 0 en caso de éxito, -1 en caso de error
+ */
+int control_open(control_t *ctl, const char *path, unsigned int *delay_ms, unsigned int *timeout_s, game_state_t *state, game_ext_t *ext, unsigned int seed);
+
+// Agrega el socket y los clientes al conjunto de select. Retorna el mayor descriptor (maxfd si no hay control).
+int control_fd_set(control_t *ctl, fd_set *readfds, int maxfd);
+
+// Acepta clientes y ejecuta los comandos completos de los descriptores listos en readfds
+void control_handle(control_t *ctl, fd_set *readfds);
+
+/**
+ * Espera atendiendo comandos mientras dure la demora entre movimientos (un cambio de demora acorta o
+ * alarga la espera en curso) y, si la partida está en pausa, hasta que se reanude. Sin socket de control
+ * no hace nada.
+ *
+ * @param ctl Socket de control
+ * @param delay true para esperar la demora (después de un movimiento), false para esperar sólo la pausa
+ *
+ * @return true si la partida estuvo en pausa
+ */
+bool control_wait(control_t *ctl, bool delay);
+
+// Cierra los clientes y elimina el socket
+void control_close(control_t *ctl);
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef EVENT_RING_H
+#define EVENT_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Anillo de eventos del juego en /game_ext para cualquier cantidad de observadores. El master publica cada
+ * evento sin esperar a nadie: no hay semáforos de por medio, cada observador lleva su propio cursor y
+ * consulta el anillo cuando quiere. Por eso los observadores se pueden conectar y desconectar en cualquier
+ * momento de la partida.
+ *
+ * Cada entrada funciona como un seqlock: version vale 2 * seq + 1 mientras el master la escribe y
+ * 2 * seq + 2 cuando el evento seq está completo. Si el lector encuentra una versión mayor, el evento fue
+ * sobreescrito (quedó más de EVENT_RING_CAPACITY eventos atrás) y debe volver a partir de una copia del
+ * estado. Para que esa copia sea coherente con el anillo, el master publica dentro de
+ * writer_enter/writer_exit: un observador que toma reader_enter, copia el estado y lee event_ring_head
+ * obtiene el punto exacto desde el que seguir.
+ */
+
+#define EVENT_RING_CAPACITY 8192 // Potencia de dos
+
+typedef enum
+{
+    EVENT_MOVE = 1,  // Movimiento válido: el jugador pasa de from a to y suma score_delta
+    EVENT_INVALID,   // Movimiento inválido (from == to)
+    EVENT_BLOCKED,   // El jugador quedó bloqueado (sin movimientos, EOF o expulsado)
+    EVENT_GAME_OVER  // Último evento de la partida
+} event_kind_t;
+
+typedef struct
+{
+    uint64_t seq;
+    uint32_t from, to;   // Índices lógicos de celda: y * board_width + x
+    int32_t score_delta;
+    uint8_t player;
+    uint8_t kind;        // event_kind_t
+} game_event_t;
+
+typedef struct
+{
+    uint64_t version;
+    game_event_t event;
+} event_slot_t;
+
+typedef struct
+{
+    uint64_t head; // Secuencia del próximo evento
+    event_slot_t slots[EVENT_RING_CAPACITY];
+} event_ring_t;
+
+typedef enum
+{
+    EVENT_RING_OK,
+    EVENT_RING_EMPTY,  // El evento todavía no se publicó
+    EVENT_RING_LAGGED  // El evento ya fue sobreescrito: hay que resincronizar
+} event_ring_status_t;
+
+// Sólo el master escribe: la secuencia del evento la asigna el anillo
+static inline void event_ring_publish(event_ring_t *ring, uint8_t kind, uint8_t player, uint32_t from, uint32_t to,
+                                      int32_t score_delta)
+{
+    uint64_t seq = ring->head;
+    event_slot_t *slot = &ring->slots[seq & (EVENT_RING_CAPACITY - 1)];
+
+    __atomic_store_n(&slot->version, 2 * seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&slot->event.seq, seq, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->event.from, from, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->event.to, to, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->event.score_delta, score_delta, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->event.player, player, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->event.kind, kind, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->version, 2 * seq + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(&ring->head, seq + 1, __ATOMIC_RELEASE);
+}
+
+static inline uint64_t event_ring_head(const event_ring_t *ring)
+{
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+}
+
+// Lee el evento seq sin bloquear ni escribir en el anillo
+static inline event_ring_status_t event_ring_read(const event_ring_t *ring, uint64_t seq, game_event_t *out)
+{
+    if (seq >= event_ring_head(ring))
+        return EVENT_RING_EMPTY;
+
+    const event_slot_t *slot = &ring->slots[seq & (EVENT_RING_CAPACITY - 1)];
+    uint64_t expected = 2 * seq + 2;
+    uint64_t before = __atomic_load_n(&slot->version, __ATOMIC_ACQUIRE);
+    if (before != expected)
+        return before > expected ? EVENT_RING_LAGGED : EVENT_RING_EMPTY;
+
+    out->seq = __atomic_load_n(&slot->event.seq, __ATOMIC_RELAXED);
+    out->from = __atomic_load_n(&slot->event.from, __ATOMIC_RELAXED);
+    out->to = __atomic_load_n(&slot->event.to, __ATOMIC_RELAXED);
+    out->score_delta = __atomic_load_n(&slot->event.score_delta, __ATOMIC_RELAXED);
+    out->player = __atomic_load_n(&slot->event.player, __ATOMIC_RELAXED);
+    out->kind = __atomic_load_n(&slot->event.kind, __ATOMIC_RELAXED);
+
+    // Si el master empezó a reescribir la entrada mientras se copiaba, la copia no sirve
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&slot->version, __ATOMIC_RELAXED) != expected)
+        return EVENT_RING_LAGGED;
+    return EVENT_RING_OK;
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef FREE_BITMAP_H
+#define FREE_BITMAP_H
+
+#include "shared_memory.h"
+#include "board_access.h"
+#include <stdint.h>
+
+/*
+ * Bitmap de celdas libres (un bit por celda, 1 = todavía se puede capturar) que el master mantiene en
+ * /game_ext junto al tablero: lo arma publish_game_ext y process_player_move apaga el bit de cada celda
+ * capturada. Cada fila ocupa FREE_BITMAP_ROW_WORDS(ancho) palabras de 64 bits (la última con ceros de
+ * relleno), así que las consultas por fila y por vecindario no cruzan filas y los recorridos leen 32 veces
+ * menos memoria que board[].
+ *
+ * Acceso: sólo escribe el master, y siempre dentro de writer_enter/writer_exit, que excluye a los lectores de
+ * los dos protocolos (semáforos y lock robusto). Un lector tiene que consultar el bitmap y el tablero en la
+ * misma sección reader_enter/reader_exit: fuera de ella, un bit puede decir que una celda está libre
+ * cuando el tablero ya la muestra capturada.
+ */
+
+#define FREE_BITMAP_ROW_WORDS(width) (((size_t)(width) + 63) / 64)
+
+static inline size_t free_bitmap_size(unsigned short width, unsigned short height)
+{
+    return FREE_BITMAP_ROW_WORDS(width) * height * sizeof(uint64_t);
+}
+
+static inline uint64_t *free_bitmap_row(game_ext_t *ext, unsigned int y)
+{
+    return (uint64_t *)((char *)ext + ext->free_bitmap_offset) + (size_t)y * ext->free_row_words;
+}
+
+static inline const uint64_t *free_bitmap_row_const(const game_ext_t *ext, unsigned int y)
+{
+    return (const uint64_t *)((const char *)ext + ext->free_bitmap_offset) + (size_t)y * ext->free_row_words;
+}
+
+static inline bool free_bitmap_test(const game_ext_t *ext, int x, int y)
+{
+    if (x < 0 || y < 0 || x >= ext->board_width || y >= ext->board_height)
+        return false;
+    return (free_bitmap_row_const(ext, (unsigned int)y)[x >> 6] >> (x & 63)) & 1;
+}
+
+static inline void free_bitmap_clear(game_ext_t *ext, int x, int y)
+{
+    uint64_t *word = &free_bitmap_row(ext, (unsigned int)y)[x >> 6];
+    uint64_t bit = 1ull << (x & 63);
+    if (*word & bit)
+    {
+        *word &= ~bit;
+        ext->free_cells--;
+    }
+}
+
+// Celdas libres de la fila y en [x0, x1)
+static inline unsigned int free_bitmap_row_count(const game_ext_t *ext, int y, int x0, int x1)
+{
+    if (x0 < 0)
+        x0 = 0;
+    if (x1 > ext->board_width)
+        x1 = ext->board_width;
+    if (y < 0 || y >= ext->board_height || x0 >= x1)
+        return 0;
+    const uint64_t *row = free_bitmap_row_const(ext, (unsigned int)y);
+    unsigned int first = (unsigned int)x0 >> 6, last = (unsigned int)(x1 - 1) >> 6;
+    uint64_t first_mask = ~0ull << (x0 & 63);
+    uint64_t last_mask = ~0ull >> (63 - ((x1 - 1) & 63));
+    if (first == last)
+        return (unsigned int)__builtin_popcountll(row[first] & first_mask & last_mask);
+    unsigned int count = (unsigned int)__builtin_popcountll(row[first] & first_mask);
+    for (unsigned int w = first + 1; w < last; ++w)
+        count += (unsigned int)__builtin_popcountll(row[w]);
+    return count + (unsigned int)__builtin_popcountll(row[last] & last_mask);
+}
+
+// Celdas libres del rectángulo [x0, x1) x [y0, y1)
+static inline unsigned long free_bitmap_rect_count(const game_ext_t *ext, int x0, int y0, int x1, int y1)
+{
+    unsigned long count = 0;
+    for (int y = y0 < 0 ? 0 : y0; y < y1 && y < ext->board_height; ++y)
+        count += free_bitmap_row_count(ext, y, x0, x1);
+    return count;
+}
+
+// Recuento completo por popcount (ext->free_cells lo mantiene el master en O(1))
+static inline unsigned long free_bitmap_count(const game_ext_t *ext)
+{
+    unsigned long count = 0;
+    size_t words = (size_t)ext->free_row_words * ext->board_height;
+    const uint64_t *bits = free_bitmap_row_const(ext, 0);
+    for (size_t w = 0; w < words; ++w)
+        count += (unsigned long)__builtin_popcountll(bits[w]);
+    return count;
+}
+
+/*
+ * Máscara de las 8 vecinas libres de (x, y): el bit d corresponde a la dirección d del protocolo
+ * (0 arriba, 1 arriba-derecha, 2 derecha, ..., 7 arriba-izquierda).
+ */
+static inline unsigned char free_bitmap_neighbors(const game_ext_t *ext, int x, int y)
+{
+    unsigned char mask = 0;
+    mask |= (unsigned char)(free_bitmap_test(ext, x, y - 1) << 0);
+    mask |= (unsigned char)(free_bitmap_test(ext, x + 1, y - 1) << 1);
+    mask |= (unsigned char)(free_bitmap_test(ext, x + 1, y) << 2);
+    mask |= (unsigned char)(free_bitmap_test(ext, x + 1, y + 1) << 3);
+    mask |= (unsigned char)(free_bitmap_test(ext, x, y + 1) << 4);
+    mask |= (unsigned char)(free_bitmap_test(ext, x - 1, y + 1) << 5);
+    mask |= (unsigned char)(free_bitmap_test(ext, x - 1, y) << 6);
+    mask |= (unsigned char)(free_bitmap_test(ext, x - 1, y - 1) << 7);
+    return mask;
+}
+
+// Arma el bitmap a partir del tablero (una vez, al inicio del juego)
+static inline void free_bitmap_build(game_ext_t *ext, const game_state_t *state)
+{
+    ext->free_cells = 0;
+    for (unsigned short y = 0; y < state->board_height; ++y)
+    {
+        uint64_t *row = free_bitmap_row(ext, y);
+        for (size_t w = 0; w < ext->free_row_words; ++w)
+            row[w] = 0;
+        for (unsigned short x = 0; x < state->board_width; ++x)
+        {
+            if (BOARD_CELL(state, x, y) > 0)
+            {
+                row[x >> 6] |= 1ull << (x & 63);
+                ext->free_cells++;
+            }
+        }
+    }
+}
+
+#endif
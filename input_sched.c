@@ -0,0 +1,260 @@
+#include "input_sched.h"
+#include "clock_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#define VTIME_SCALE (1u << 20) // Costo virtual de un movimiento con peso 1
+
+static const char *policy_names[] = {"none", "coalesce", "drop"};
+
+static int parse_positive(const char *str, char **end, unsigned int *value) {
+    errno = 0;
+    long v = strtol(str, end, 10);
+    if (errno != 0 || *end == str || v < 1 || v > 1000000) {
+        return -1;
+    }
+    *value = (unsigned int)v;
+    return 0;
+}
+
+int parse_input_rate(const char *spec, input_sched_config_t *config) {
+    char *end;
+    if (parse_positive(spec, &end, &config->rate) != 0) {
+        return -1;
+    }
+    config->burst = DEFAULT_INPUT_BURST;
+    if (*end == ':' && parse_positive(end + 1, &end, &config->burst) != 0) {
+        return -1;
+    }
+    if (*end != '\0') {
+        return -1;
+    }
+    config->enabled = true;
+    return 0;
+}
+
+int parse_overload_policy(const char *spec, input_sched_config_t *config) {
+    char *end;
+    if (strcmp(spec, "none") == 0) {
+        config->policy = OVERLOAD_NONE;
+    } else if (strcmp(spec, "coalesce") == 0) {
+        config->policy = OVERLOAD_COALESCE;
+    } else if (strncmp(spec, "drop", 4) == 0) {
+        config->policy = OVERLOAD_DROP;
+        config->max_queue = DEFAULT_DROP_QUEUE;
+        if (spec[4] == ':') {
+            if (parse_positive(spec + 5, &end, &config->max_queue) != 0 || *end != '\0') {
+                return -1;
+            }
+        } else if (spec[4] != '\0') {
+            return -1;
+        }
+    } else {
+        return -1;
+    }
+    config->enabled = true;
+    return 0;
+}
+
+int parse_input_weights(const char *spec, input_sched_config_t *config) {
+    const char *p = spec;
+    for (int i = 0; i < MAX_PLAYERS; ++i) {
+        char *end;
+        if (parse_positive(p, &end, &config->weights[i]) != 0) {
+            return -1;
+        }
+        if (*end == '\0') {
+            config->enabled = true;
+            return 0;
+        }
+        if (*end != ',') {
+            return -1;
+        }
+        p = end + 1;
+    }
+    return -1; // Más pesos que jugadores posibles
+}
+
+void input_sched_init(input_sched_t *sched, const input_sched_config_t *config, int num_players) {
+    memset(sched, 0, sizeof(*sched));
+    sched->config = *config;
+    sched->num_players = num_players;
+    uint64_t now = monotonic_ns();
+    for (int i = 0; i < num_players; ++i) {
+        input_player_t *p = &sched->players[i];
+        p->weight = config->weights[i] > 0 ? config->weights[i] : 1;
+        p->tokens = config->burst;
+        p->last_refill_ns = now;
+    }
+}
+
+static void refill_tokens(input_sched_t *sched, input_player_t *p, uint64_t now) {
+    double limit = sched->config.burst;
+    p->tokens += (double)(now - p->last_refill_ns) * sched->config.rate * p->weight / 1e9;
+    if (p->tokens > limit) {
+        p->tokens = limit;
+    }
+    p->last_refill_ns = now;
+}
+
+static unsigned int queued_bytes(int fd) {
+    int queued = 0;
+    if (ioctl(fd, FIONREAD, &queued) == -1) {
+        return 0;
+    }
+    return queued > 0 ? (unsigned int)queued : 0;
+}
+
+int input_sched_fd_set(input_sched_t *sched, fd_set *readfds, int pipe_fds[][2], struct timeval *token_wait) {
+    FD_ZERO(readfds);
+    token_wait->tv_sec = 0;
+    token_wait->tv_usec = 0;
+    int maxfd = -1;
+    uint64_t now = monotonic_ns();
+    uint64_t min_wait_ns = 0;
+
+    for (int i = 0; i < sched->num_players; ++i) {
+        int fd = pipe_fds[i][0];
+        if (fd < 0) {
+            continue;
+        }
+        if (fd > maxfd) {
+            maxfd = fd;
+        }
+        input_player_t *p = &sched->players[i];
+        if (sched->config.rate > 0) {
+            refill_tokens(sched, p, now);
+            if (p->tokens < 1.0) {
+                // Sin tokens: queda fuera del select hasta que se reponga uno
+                if (queued_bytes(fd) > 0) {
+                    p->throttled++;
+                }
+                uint64_t wait_ns = (uint64_t)((1.0 - p->tokens) * 1e9 / ((double)sched->config.rate * p->weight)) + 1;
+                if (min_wait_ns == 0 || wait_ns < min_wait_ns) {
+                    min_wait_ns = wait_ns;
+                }
+                continue;
+            }
+        }
+        FD_SET(fd, readfds);
+    }
+
+    if (min_wait_ns > 0) {
+        token_wait->tv_sec = (time_t)(min_wait_ns / 1000000000ull);
+        token_wait->tv_usec = (suseconds_t)((min_wait_ns % 1000000000ull + 999) / 1000);
+    }
+    return maxfd;
+}
+
+int input_sched_pick(input_sched_t *sched, fd_set *readfds, int pipe_fds[][2]) {
+    int best = -1;
+    uint64_t best_vtime = 0;
+    uint64_t now = monotonic_ns();
+
+    for (int j = 0; j < sched->num_players; ++j) {
+        int idx = (sched->start_index + j) % sched->num_players;
+        if (pipe_fds[idx][0] < 0 || !FD_ISSET(pipe_fds[idx][0], readfds)) {
+            continue;
+        }
+        input_player_t *p = &sched->players[idx];
+        if (p->ready_since_ns == 0) {
+            p->ready_since_ns = now;
+        }
+        // Un jugador que estuvo inactivo no acumula ventaja: parte del tiempo virtual del sistema
+        uint64_t vtime = p->vtime > sched->vtime ? p->vtime : sched->vtime;
+        if (best == -1 || vtime < best_vtime) {
+            best = idx;
+            best_vtime = vtime;
+        }
+    }
+
+    if (best != -1) {
+        sched->start_index = (best + 1) % sched->num_players;
+    }
+    return best;
+}
+
+ssize_t input_sched_read(input_sched_t *sched, int pipe_fd, int idx, unsigned char *move) {
+    input_player_t *p = &sched->players[idx];
+    unsigned char buffer[INPUT_READ_MAX];
+    unsigned int queued = queued_bytes(pipe_fd);
+    if (queued > p->max_queued) {
+        p->max_queued = queued;
+    }
+
+    size_t to_read = 1;
+    if (sched->config.policy == OVERLOAD_COALESCE && queued > 1) {
+        to_read = queued;
+    } else if (sched->config.policy == OVERLOAD_DROP && queued > sched->config.max_queue) {
+        to_read = queued - sched->config.max_queue + 1;
+    }
+    if (to_read > INPUT_READ_MAX) {
+        to_read = INPUT_READ_MAX;
+    }
+
+    ssize_t nread = read(pipe_fd, buffer, to_read);
+    if (nread <= 0) {
+        return nread;
+    }
+
+    if (sched->config.policy == OVERLOAD_COALESCE) {
+        // El movimiento más reciente reemplaza a los anteriores
+        *move = buffer[nread - 1];
+        p->coalesced += (unsigned long)(nread - 1);
+    } else {
+        // Se descartan los más viejos y se atiende el siguiente en orden de llegada
+        *move = buffer[nread - 1];
+        p->dropped += (unsigned long)(nread - 1);
+    }
+
+    uint64_t now = monotonic_ns();
+    if (p->ready_since_ns != 0) {
+        uint64_t wait = now - p->ready_since_ns;
+        p->total_wait_ns += wait;
+        if (wait > p->max_wait_ns) {
+            p->max_wait_ns = wait;
+        }
+    }
+    p->ready_since_ns = (unsigned int)nread < queued ? now : 0;
+
+    uint64_t start = p->vtime > sched->vtime ? p->vtime : sched->vtime;
+    sched->vtime = start;
+    p->vtime = start + VTIME_SCALE / p->weight;
+    p->served++;
+    if (sched->config.rate > 0) {
+        p->tokens -= 1.0;
+    }
+    return nread;
+}
+
+void input_sched_print_stats(const input_sched_t *sched) {
+    const input_sched_config_t *c = &sched->config;
+    if (c->rate > 0) {
+        printf("Input scheduler: %u moves/s per weight, burst %u, overload policy %s", c->rate, c->burst, policy_names[c->policy]);
+    } else {
+        printf("Input scheduler: unlimited rate, overload policy %s", policy_names[c->policy]);
+    }
+    if (c->policy == OVERLOAD_DROP) {
+        printf(" (max queue %u)", c->max_queue);
+    }
+    printf("\n");
+
+    double sum = 0, sum_sq = 0;
+    for (int i = 0; i < sched->num_players; ++i) {
+        const input_player_t *p = &sched->players[i];
+        double avg_wait_us = p->served > 0 ? (double)p->total_wait_ns / p->served / 1000.0 : 0.0;
+        printf("Player %d: weight %u, served %lu, coalesced %lu, dropped %lu, throttled %lu, max queued %u, wait avg %.1f us / max %.1f us\n",
+               i, p->weight, p->served, p->coalesced, p->dropped, p->throttled, p->max_queued,
+               avg_wait_us, (double)p->max_wait_ns / 1000.0);
+        double share = (double)p->served / p->weight;
+        sum += share;
+        sum_sq += share * share;
+    }
+    if (sum_sq > 0) {
+        printf("Fairness (Jain index over served/weight): %.3f\n", sum * sum / (sched->num_players * sum_sq));
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef INPUT_SCHED_H
+#define INPUT_SCHED_H
+
+#include "shared_memory.h"
+#include <stdint.h>
+#include <sys/select.h>
+#include <sys/time.h>
+
+/*
+ * Planificador de la entrada de los jugadores en el master. Reemplaza el recorrido circular de los pipes:
+ *
+ * - Reparto justo ponderado: entre los pipes listos se atiende al jugador con menor tiempo virtual
+ *   (movimientos atendidos / peso), así un jugador que escribe sin parar no desplaza a los demás.
+ * - Token bucket opcional por jugador (rate * peso movimientos por segundo, hasta burst acumulados). Un
+ *   jugador sin tokens queda fuera del select hasta que se repongan, y su entrada espera en el pipe.
+ * - Política de sobrecarga para los movimientos viejos encolados en el pipe (ver overload_policy_t).
+ *
+ * Cada lectura consume a lo sumo INPUT_READ_MAX bytes, de modo que el trabajo del master por iteración
+ * queda acotado sin importar cuánto escriba un jugador.
+ */
+
+#define INPUT_READ_MAX 256
+#define DEFAULT_INPUT_BURST 4
+#define DEFAULT_DROP_QUEUE 4
+
+typedef enum
+{
+    OVERLOAD_NONE,     // Se atiende en orden de llegada, sin descartar nada
+    OVERLOAD_COALESCE, // Si hay varios movimientos encolados se aplica sólo el más reciente
+    OVERLOAD_DROP      // Si hay más de max_queue encolados se descartan los más viejos
+} overload_policy_t;
+
+typedef struct
+{
+    bool enabled;                        // Algún parámetro distinto del comportamiento por defecto
+    unsigned int rate;                   // -q: movimientos por segundo por unidad de peso (0 = sin límite)
+    unsigned int burst;                  // -q rate:burst: tokens acumulables por jugador
+    overload_policy_t policy;            // -o
+    unsigned int max_queue;              // -o drop:N
+    unsigned int weights[MAX_PLAYERS];   // -W: peso de cada jugador (1 por defecto)
+} input_sched_config_t;
+
+typedef struct
+{
+    unsigned int weight;
+    double tokens;
+    uint64_t last_refill_ns;
+    uint64_t vtime;          // Tiempo virtual de finalización del último movimiento atendido
+    uint64_t ready_since_ns; // Primera vez que se vio el pipe listo sin atenderlo (0 si no)
+
+    // Métricas
+    unsigned long served;
+    unsigned long coalesced;
+    unsigned long dropped;
+    unsigned long throttled; // Iteraciones en las que tenía entrada pero no tokens
+    unsigned int max_queued; // Máximo de bytes observados en el pipe
+    uint64_t total_wait_ns;
+    uint64_t max_wait_ns;
+} input_player_t;
+
+typedef struct
+{
+    input_sched_config_t config;
+    int num_players;
+    uint64_t vtime; // Tiempo virtual del sistema: el del último movimiento atendido
+    int start_index;
+    input_player_t players[MAX_PLAYERS];
+} input_sched_t;
+
+// Parsea "rate" o "rate:burst". Retorna 0 o -1.
+int parse_input_rate(const char *spec, input_sched_config_t *config);
+
+// Parsea "none", "coalesce", "drop" o "drop:N". Retorna 0 o -1.
+int parse_overload_policy(const char *spec, input_sched_config_t *config);
+
+// Parsea pesos separados por coma ("2,1,1"), asignados a los jugadores en orden. Retorna 0 o -1.
+int parse_input_weights(const char *spec, input_sched_config_t *config);
+
+void input_sched_init(input_sched_t *sched, const input_sched_config_t *config, int num_players);
+
+/**
+ * Arma el conjunto de descriptores para select con los jugadores activos que tienen tokens.
+ *
+ * @param sched Planificador
+ * @param readfds Conjunto a completar
+ * @param pipe_fds Pipes de los jugadores (-1 si están cerrados)
+ * @param token_wait Si algún jugador activo espera tokens, tiempo hasta que se reponga el primero;
+ *                   si no, se deja en {0, 0}
+ *
+ * @return Mayor descriptor agregado, -1 si no queda ningún jugador activo. Con todos los jugadores
+ *         activos sin tokens retorna el mayor descriptor abierto sin agregarlo, para esperar token_wait.
+ */
+int input_sched_fd_set(input_sched_t *sched, fd_set *readfds, int pipe_fds[][2], struct timeval *token_wait);
+
+/**
+ * Elige, entre los pipes listos, al jugador con menor tiempo virtual (empates en forma circular).
+ *
+ * @return Índice del jugador, -1 si no hay ninguno listo
+ */
+int input_sched_pick(input_sched_t *sched, fd_set *readfds, int pipe_fds[][2]);
+
+/**
+ * Lee el próximo movimiento del jugador aplicando la política de sobrecarga y descuenta un token.
+ *
+ * @param sched Planificador
+ * @param pipe_fd Extremo de lectura del pipe del jugador
+ * @param idx Índice del jugador
+ * @param move Movimiento a procesar
+ *
+ * @return Bytes consumidos del pipe (>= 1), 0 en EOF, -1 en error
+ */
+ssize_t input_sched_read(input_sched_t *sched, int pipe_fd, int idx, unsigned char *move);
+
+// Imprime las métricas por jugador y el índice de justicia de Jain sobre movimientos atendidos / peso
+void input_sched_print_stats(const input_sched_t *sched);
+
+#endif
@@ -0,0 +1,90 @@
+#include "latency_hist.h"
+#include <string.h>
+
+static unsigned int bucket_of(uint64_t value) {
+    if (value < HIST_SUB_BUCKETS) {
+        return (unsigned int)value;
+    }
+    unsigned int magnitude = 63 - (unsigned int)__builtin_clzll(value);
+    if (magnitude > HIST_MAX_MAGNITUDE) {
+        return HIST_BUCKETS - 1;
+    }
+    unsigned int shift = magnitude - HIST_SUB_BITS;
+    return (shift + 1) * HIST_SUB_BUCKETS + (unsigned int)((value >> shift) & (HIST_SUB_BUCKETS - 1));
+}
+
+// Mayor valor que cae en el bucket
+static uint64_t bucket_upper(unsigned int bucket) {
+    if (bucket < HIST_SUB_BUCKETS) {
+        return bucket;
+    }
+    unsigned int shift = bucket / HIST_SUB_BUCKETS - 1;
+    uint64_t lower = (uint64_t)(HIST_SUB_BUCKETS + bucket % HIST_SUB_BUCKETS) << shift;
+    return lower + ((1ull << shift) - 1);
+}
+
+void latency_hist_reset(latency_hist_t *hist) {
+    memset(hist, 0, sizeof(*hist));
+}
+
+void latency_hist_record(latency_hist_t *hist, uint64_t value_us) {
+    hist->counts[bucket_of(value_us)]++;
+    if (hist->total == 0 || value_us < hist->min_us) {
+        hist->min_us = value_us;
+    }
+    if (value_us > hist->max_us) {
+        hist->max_us = value_us;
+    }
+    hist->sum_us += value_us;
+    hist->total++;
+}
+
+uint64_t latency_hist_percentile(const latency_hist_t *hist, double p) {
+    if (hist->total == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(p / 100.0 * hist->total + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (unsigned int b = 0; b < HIST_BUCKETS; ++b) {
+        seen += hist->counts[b];
+        if (seen >= rank) {
+            uint64_t upper = bucket_upper(b);
+            return upper < hist->max_us ? upper : hist->max_us;
+        }
+    }
+    return hist->max_us;
+}
+
+void latency_hist_print(const latency_hist_t *hist, FILE *out, const char *indent) {
+    if (hist->total == 0) {
+        fprintf(out, "%sresponse time: no samples\n", indent);
+        return;
+    }
+    fprintf(out, "%sresponse time (us): n=%llu min=%llu avg=%llu p50=%llu p90=%llu p99=%llu p99.9=%llu max=%llu\n",
+            indent, (unsigned long long)hist->total, (unsigned long long)hist->min_us,
+            (unsigned long long)(hist->sum_us / hist->total),
+            (unsigned long long)latency_hist_percentile(hist, 50),
+            (unsigned long long)latency_hist_percentile(hist, 90),
+            (unsigned long long)latency_hist_percentile(hist, 99),
+            (unsigned long long)latency_hist_percentile(hist, 99.9),
+            (unsigned long long)hist->max_us);
+
+    // Distribución agrupada por potencias de dos: [2^k, 2^(k+1)) us
+    fprintf(out, "%shistogram (us):", indent);
+    unsigned int b = 0;
+    for (unsigned int k = 0; k <= HIST_MAX_MAGNITUDE; ++k) {
+        uint64_t upper = (2ull << k) - 1;
+        uint64_t count = 0;
+        while (b < HIST_BUCKETS && bucket_upper(b) <= upper) {
+            count += hist->counts[b++];
+        }
+        if (count > 0) {
+            fprintf(out, " [%llu,%llu):%llu", (unsigned long long)(k == 0 ? 0 : 1ull << k),
+                    (unsigned long long)(upper + 1), (unsigned long long)count);
+        }
+    }
+    fprintf(out, "\n");
+}
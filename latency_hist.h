@@ -0,0 +1,36 @@
+#ifndef LATENCY_HIST_H
+#define LATENCY_HIST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Histograma de latencias al estilo HDR, con memoria fija y registro O(1). Los valores (en microsegundos)
+ * menores a 2^HIST_SUB_BITS tienen un bucket propio; por encima, cada potencia de dos se divide en
+ * 2^HIST_SUB_BITS buckets iguales, así el error relativo de cualquier percentil es menor a 1/16.
+ */
+
+#define HIST_SUB_BITS 4
+#define HIST_SUB_BUCKETS (1u << HIST_SUB_BITS)
+#define HIST_MAX_MAGNITUDE 40 // Valores de hasta 2^40 us; los mayores se cuentan en el último bucket
+#define HIST_BUCKETS ((HIST_MAX_MAGNITUDE - HIST_SUB_BITS + 2) * HIST_SUB_BUCKETS)
+
+typedef struct
+{
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t total;
+    uint64_t min_us;
+    uint64_t max_us;
+    uint64_t sum_us;
+} latency_hist_t;
+
+void latency_hist_reset(latency_hist_t *hist);
+void latency_hist_record(latency_hist_t *hist, uint64_t value_us);
+
+// Valor (límite superior de su bucket) por debajo del cual está el p % de las muestras; 0 si está vacío
+uint64_t latency_hist_percentile(const latency_hist_t *hist, double p);
+
+// Imprime una línea con cantidad, mínimo, percentiles y máximo, y otra con la distribución por potencias de dos
+void latency_hist_print(const latency_hist_t *hist, FILE *out, const char *indent);
+
+#endif
@@ -19,12 +19,17 @@ char *view_path = NULL;
 char *player_paths[MAX_PLAYERS];
 int num_players = 0;
 unsigned int seed = 0;
+master_options_t opts = {0};
 
 int main(int argc, char *argv[])
 {
     seed = (unsigned int)time(NULL);
 
-    if (parse_arguments(argc, argv, &width, &height, &delay_ms, &timeout_s, &seed, &view_path, player_paths, &num_players) != 0)
+    if (parse_arguments(argc, argv, &width, &height, &delay_ms, &timeout_s, &seed, &view_path, player_paths, &num_players, &opts) != 0)
+        return EXIT_FAILURE;
+
+    board_file_t board_file;
+    if (opts.board_path != NULL && load_board_file(opts.board_path, &board_file, &width, &height) != 0)
         return EXIT_FAILURE;
 
     game_state_t *state = create_game_state(width, height); //(!) chequear que create_game_state maneje el caso MAP_FAILED internamente y devuelva NULL en ese caso --> Chequeado! Flor
@@ -35,13 +40,39 @@ int main(int argc, char *argv[])
     if (check_game_sync(game_sync, state, width, height) != 0)
         return EXIT_FAILURE;
 
-    initialize_game_state(state, player_paths, num_players, seed);
+    game_ext_t *game_ext = create_game_ext(width, height, opts.lock_mode);
+    if (check_game_ext(game_ext, game_sync, state, width, height) != 0)
+        return EXIT_FAILURE;
+
+    if (opts.board_path != NULL) {
+        initialize_game_state(state, player_paths, num_players, seed, board_file.cells);
+        board_file_close(&board_file);
+    } else {
+        initialize_game_state(state, player_paths, num_players, seed, NULL);
+    }
+    publish_game_ext(game_ext, state);
+
+    // El servidor de espectadores arranca antes que los jugadores, así no hereda sus pipes
+    pid_t spectator_pid = -1;
+    if (opts.spectator_path != NULL) {
+        spectator_pid = spectator_server_start(opts.spectator_path, state, game_sync, game_ext);
+        if (spectator_pid == -1) {
+            fprintf(stderr, "Advertencia: no se pudo crear el servidor de espectadores. Continuando sin él.\n");
+        }
+    }
+
+    // El socket de control se atiende desde el bucle principal
+    control_t control = {.listen_fd = -1};
+    if (opts.control_path != NULL && control_open(&control, opts.control_path, &delay_ms, &timeout_s, state, game_ext, seed) != 0) {
+        fprintf(stderr, "Advertencia: no se pudo crear el socket de control. Continuando sin él.\n");
+    }
+    bool control_enabled = control.listen_fd != -1;
 
    pid_t view_pid = -1;
     bool has_view = (view_path != NULL);
 
     if (has_view) {
-        view_pid = create_view_process(state, game_sync, view_path, width, height);
+        view_pid = create_view_process(state, game_sync, view_path, width, height, &opts);
         if (view_pid == -1) {
             fprintf(stderr, "Error al crear proceso de vista. Continuando sin vista.\n");
             has_view = false;
@@ -51,15 +82,23 @@ int main(int argc, char *argv[])
     int pipe_fds[MAX_PLAYERS][2];
     pid_t player_pids[MAX_PLAYERS];
 
-    if (create_player_processes(state, game_sync, player_paths, num_players, pipe_fds, player_pids) != 0) {
+    if (create_player_processes(state, game_sync, game_ext, player_paths, num_players, pipe_fds, player_pids, &opts) != 0) {
         // Si la vista se creó correctamente, necesitamos limpiarla antes de salir
         if (has_view && view_pid > 0) {
             kill(view_pid, SIGTERM);
             waitpid(view_pid, NULL, 0);
         }
+        if (spectator_pid > 0) {
+            kill(spectator_pid, SIGTERM);
+            waitpid(spectator_pid, NULL, 0);
+        }
+        control_close(&control);
         return EXIT_FAILURE;
     }
 
+    // Recién ahora, con todos los hijos creados: ni la afinidad ni el nice del master se heredan
+    apply_master_placement(&opts);
+
     /* === imprimir estado inicial antes de los movimientos iniciales de los jugadores === */
 
     if (has_view) {
@@ -67,30 +106,46 @@ int main(int argc, char *argv[])
         wait_view_done(game_sync);
     }
 
-    for (int i = 0; i < num_players; ++i){
-        allow_player_move(game_sync, i);
-    }
+    response_monitor_t monitor;
+    response_monitor_init(&monitor, &opts.eviction, num_players);
+    grant_initial_credits(game_sync, &monitor, num_players, opts.credit_depth);
 
     // Bucle principal de recepción de movimientos
     time_t last_valid_time = time(NULL);
     bool all_blocked_flag = false;
-    int start_index = 0;
+    unsigned int credit_depth = opts.credit_depth > 0 ? opts.credit_depth : DEFAULT_CREDIT_DEPTH;
+    input_sched_t input_sched;
+    input_sched_init(&input_sched, &opts.input, num_players);
 
     // loop principal
     while (true){
+        // Pausa pedida por el socket de control mientras se esperaba un movimiento
+        if (control.paused) {
+            response_monitor_pacing_begin(&monitor);
+            if (control_wait(&control, false)) {
+                last_valid_time = time(NULL);
+            }
+            response_monitor_pacing_end(&monitor);
+        }
         long remaining = calculate_remaining_time(last_valid_time, timeout_s);
         if (remaining <= 0){
             break;
         }
         fd_set readfds;
-        int maxfd = configure_fd_set(&readfds, pipe_fds, num_players);
+        struct timeval token_wait;
+        int maxfd = input_sched_fd_set(&input_sched, &readfds, pipe_fds, &token_wait);
         if (maxfd == -1){
             // No quedan jugadores activos
             break;
         }
+        maxfd = control_fd_set(&control, &readfds, maxfd);
+        bool throttled = token_wait.tv_sec != 0 || token_wait.tv_usec != 0;
         struct timeval tv;
         tv.tv_sec = remaining;
         tv.tv_usec = 0;
+        if (throttled && token_wait.tv_sec < remaining) {
+            tv = token_wait;
+        }
         int res = select(maxfd + 1, &readfds, NULL, NULL, &tv);
         if (res < 0)
         {
@@ -100,21 +155,24 @@ int main(int argc, char *argv[])
             break;
         }
         else if (res == 0){
+            if (throttled)
+                continue; // Se repusieron tokens; el tiempo límite se vuelve a controlar arriba
             // Se agotó el tiempo sin movimientos válidos
             break;
         }
-        int ready_index = search_pipe_ready(&readfds, pipe_fds, num_players, &start_index);
+        control_handle(&control, &readfds);
+        int ready_index = input_sched_pick(&input_sched, &readfds, pipe_fds);
         if (ready_index == -1){
             // Ningún FD encontrado listo
             continue;
         }
         int i = ready_index;
         unsigned char move;
-        ssize_t nread = read(pipe_fds[i][0], &move, 1);
+        ssize_t nread = input_sched_read(&input_sched, pipe_fds[i][0], i, &move);
         if (nread <= 0){
             if (nread == 0){ // EOF
                 writer_enter(game_sync);
-                state->players[i].is_blocked = true;
+                block_player(state, game_ext, i);
                 all_blocked_flag = all_players_blocked(state);
                 writer_exit(game_sync);
 
@@ -129,17 +187,36 @@ int main(int argc, char *argv[])
 
     
         unsigned char direction = move;
+        bool accepted = nread <= 0 || response_monitor_arrival(&monitor, i, (unsigned int)nread);
 
         writer_enter(game_sync);
-        bool move_valid = process_player_move(state, i, direction, DIR_OFFSETS);    
-        update_lock_status(state, DIR_OFFSETS, move_valid);
+        bool move_valid = false;
+        if (accepted) {
+            move_valid = process_player_move(state, game_ext, i, direction, DIR_OFFSETS);
+        } else if (response_monitor_evicted(&monitor, i)) {
+            block_player(state, game_ext, i); // Expulsado por lento: no recibe más créditos
+        }
+        update_lock_status(state, game_ext, DIR_OFFSETS, move_valid);
         all_blocked_flag = all_players_blocked(state);
         writer_exit(game_sync);
-        bool continue_game = handle_move_aftermath(state, game_sync, has_view, pipe_fds, i, move_valid, delay_ms, all_blocked_flag, &last_valid_time);
+        unsigned int credits = nread > 0 ? ((unsigned int)nread < credit_depth ? (unsigned int)nread : credit_depth) : 0;
+        bool continue_game = handle_move_aftermath(state, game_sync, has_view, pipe_fds, i, move_valid, credits, &monitor, control_enabled ? 0 : delay_ms, all_blocked_flag, &last_valid_time);
 
         if (!continue_game) {
             break;  // Salir del bucle principal
         }
+        // Con socket de control la demora se espera atendiendo comandos (y una pausa, hasta que se reanude)
+        if (control_enabled) {
+            response_monitor_pacing_begin(&monitor);
+            if (control_wait(&control, true)) {
+                last_valid_time = time(NULL);
+            }
+            response_monitor_pacing_end(&monitor);
+        }
     }
-    return finalize_game(state, game_sync, has_view, view_pid, pipe_fds, player_pids, num_players);
+    control_close(&control);
+    int status = finalize_game(state, game_sync, game_ext, has_view, view_pid, spectator_pid, pipe_fds, player_pids, num_players, &monitor, &opts.player_limits, opts.shutdown_ms);
+    if (opts.input.enabled)
+        input_sched_print_stats(&input_sched);
+    return status;
 }
@@ -2,7 +2,7 @@
 
 static void print_usage(const char *progname)
 {
-    fprintf(stderr, "Uso: %s [-w ancho] [-h alto] [-d delay_ms] [-t timeout_s] [-s semilla] [-v ruta_vista] -p jugador1 [jugador2 ...]\n", progname);
+    fprintf(stderr, "Uso: %s [-w ancho] [-h alto] [-d delay_ms] [-t timeout_s] [-s semilla] [-b tablero] [-a cpus_master] [-A cpus_jugadores] [-V cpus_vista] [-r politica] [-l sem|robust] [-k creditos] [-q tasa[:rafaga]] [-o politica] [-W pesos] [-E politica] [-x plazo_ms] [-S socket_espectadores] [-C socket_control] [-R limites] [-v ruta_vista] -p jugador1 [jugador2 ...]\n", progname);
 }
 
 static int invalid_dimension(unsigned short value, const char* dimension_name) {
@@ -11,13 +11,13 @@ static int invalid_dimension(unsigned short value, const char* dimension_name) {
     return -1;
 }
 
-int parse_arguments(int argc, char *argv[], unsigned short *width, unsigned short *height, unsigned int *delay_ms, unsigned int *timeout_s, unsigned int *seed, char **view_path, char *player_paths[], int *num_players)
+int parse_arguments(int argc, char *argv[], unsigned short *width, unsigned short *height, unsigned int *delay_ms, unsigned int *timeout_s, unsigned int *seed, char **view_path, char *player_paths[], int *num_players, master_options_t *opts)
 {
     // Procesar opciones de posibles argumentos
     bool p_flag_present = false;
     int opt; 
     unsigned short new_width, new_height;
-    while ((opt = getopt(argc, argv, "w:h:d:t:s:v:p")) != -1)
+    while ((opt = getopt(argc, argv, "w:h:d:t:s:b:a:A:V:r:l:k:q:o:W:E:x:S:C:R:v:p")) != -1)
     {
         switch (opt)
         {
@@ -44,6 +44,100 @@ int parse_arguments(int argc, char *argv[], unsigned short *width, unsigned shor
         case 's':
             *seed = (unsigned int)atoi(optarg);
             break;
+        case 'b':
+            opts->board_path = optarg;
+            break;
+        case 'a':
+            if (parse_cpu_list(optarg, &opts->master_cpus) != 0) {
+                fprintf(stderr, "Error: Lista de CPUs inválida para el master: '%s'\n", optarg);
+                return -1;
+            }
+            opts->master_cpus_set = true;
+            break;
+        case 'A':
+            opts->player_cpu_sets = parse_cpu_sets(optarg, opts->player_cpus, MAX_PLAYERS);
+            if (opts->player_cpu_sets < 0) {
+                fprintf(stderr, "Error: Conjuntos de CPUs inválidos para los jugadores: '%s'\n", optarg);
+                return -1;
+            }
+            break;
+        case 'V':
+            if (parse_cpu_list(optarg, &opts->view_cpus) != 0) {
+                fprintf(stderr, "Error: Lista de CPUs inválida para la vista: '%s'\n", optarg);
+                return -1;
+            }
+            opts->view_cpus_set = true;
+            break;
+        case 'r':
+            if (parse_sched_policy(optarg, &opts->master_sched) != 0) {
+                fprintf(stderr, "Error: Política de planificación inválida: '%s' (use fifo:prio, rr:prio o nice:valor)\n", optarg);
+                return -1;
+            }
+            break;
+        case 'l':
+            if (strcmp(optarg, "sem") == 0) {
+                opts->lock_mode = LOCK_MODE_SEM;
+            } else if (strcmp(optarg, "robust") == 0) {
+                opts->lock_mode = LOCK_MODE_ROBUST;
+            } else {
+                fprintf(stderr, "Error: Tipo de lock inválido: '%s' (use sem o robust)\n", optarg);
+                return -1;
+            }
+            break;
+        case 'k': {
+            int depth = atoi(optarg);
+            if (depth < 1 || depth > MAX_CREDIT_DEPTH) {
+                fprintf(stderr, "Error: Profundidad de créditos inválida: '%s' (debe estar entre 1 y %d)\n", optarg, MAX_CREDIT_DEPTH);
+                return -1;
+            }
+            opts->credit_depth = (unsigned int)depth;
+            break;
+        }
+        case 'q':
+            if (parse_input_rate(optarg, &opts->input) != 0) {
+                fprintf(stderr, "Error: Límite de movimientos inválido: '%s' (use movimientos_por_segundo[:rafaga])\n", optarg);
+                return -1;
+            }
+            break;
+        case 'o':
+            if (parse_overload_policy(optarg, &opts->input) != 0) {
+                fprintf(stderr, "Error: Política de sobrecarga inválida: '%s' (use none, coalesce o drop[:max])\n", optarg);
+                return -1;
+            }
+            break;
+        case 'W':
+            if (parse_input_weights(optarg, &opts->input) != 0) {
+                fprintf(stderr, "Error: Pesos inválidos: '%s' (use enteros positivos separados por coma)\n", optarg);
+                return -1;
+            }
+            break;
+        case 'E':
+            if (parse_eviction_policy(optarg, &opts->eviction) != 0) {
+                fprintf(stderr, "Error: Política de expulsión inválida: '%s' (use block:ms[:demoras] o skip:ms[:demoras])\n", optarg);
+                return -1;
+            }
+            break;
+        case 'x': {
+            int shutdown_ms = atoi(optarg);
+            if (shutdown_ms < 1) {
+                fprintf(stderr, "Error: Plazo de terminación inválido: '%s'\n", optarg);
+                return -1;
+            }
+            opts->shutdown_ms = (unsigned int)shutdown_ms;
+            break;
+        }
+        case 'S':
+            opts->spectator_path = optarg;
+            break;
+        case 'C':
+            opts->control_path = optarg;
+            break;
+        case 'R':
+            if (parse_player_limits(optarg, &opts->player_limits) != 0) {
+                fprintf(stderr, "Error: Límites inválidos: '%s' (use cpu=s,as=MiB,files=n,nice=n,cgroup=ruta,mem=MiB,cpu_pct=n; mem y cpu_pct requieren cgroup)\n", optarg);
+                return -1;
+            }
+            break;
         case 'v':
             *view_path = optarg;
             break;
@@ -83,7 +177,7 @@ int parse_arguments(int argc, char *argv[], unsigned short *width, unsigned shor
     return 0;
 }
 
-void cleanup_resources(game_state_t *state, game_sync_t *sync, int pipe_fds[][2], int num_players)
+void cleanup_resources(game_state_t *state, game_sync_t *sync, game_ext_t *ext, int pipe_fds[][2], int num_players)
 {
     // Cerrar los pipes
     for (int i = 0; i < num_players; ++i)
@@ -100,6 +194,12 @@ void cleanup_resources(game_state_t *state, game_sync_t *sync, int pipe_fds[][2]
         close_game_sync(sync);
     }
 
+    if (ext != NULL)
+    {
+        sync_release_robust_lock();
+        close_game_ext(ext);
+    }
+
     if (state != NULL)
     {
         close_game_state(state, state->board_width, state->board_height);
@@ -107,9 +207,27 @@ void cleanup_resources(game_state_t *state, game_sync_t *sync, int pipe_fds[][2]
 
     unlink_shared_memory(GAME_STATE_NAME);
     unlink_shared_memory(GAME_SYNC_NAME);
+    unlink_shared_memory(GAME_EXT_NAME);
+}
+
+int load_board_file(const char *path, board_file_t *bf, unsigned short *width, unsigned short *height) {
+    if (board_file_open(path, bf) != 0) {
+        return -1;
+    }
+    if (bf->header->board_width < 10) {
+        board_file_close(bf);
+        return invalid_dimension(bf->header->board_width, "ancho");
+    }
+    if (bf->header->board_height < 10) {
+        board_file_close(bf);
+        return invalid_dimension(bf->header->board_height, "alto");
+    }
+    *width = bf->header->board_width;
+    *height = bf->header->board_height;
+    return 0;
 }
 
-void initialize_game_state(game_state_t *state, char *player_paths[MAX_PLAYERS], int num_players, unsigned int seed){
+void initialize_game_state(game_state_t *state, char *player_paths[MAX_PLAYERS], int num_players, unsigned int seed, const int *board_cells){
     
     state->player_count = num_players;
     state->game_over = false;
@@ -117,6 +235,7 @@ void initialize_game_state(game_state_t *state, char *player_paths[MAX_PLAYERS],
     for (int i = 0; i < num_players; ++i)
     {
         player_t *p = &state->players[i];
+        player_hot_t *hot = PLAYER_HOT(state, i);
 
         const char *path = player_paths[i];
         const char *basename = strrchr(path, '/');
@@ -124,29 +243,32 @@ void initialize_game_state(game_state_t *state, char *player_paths[MAX_PLAYERS],
         strncpy(p->player_name, basename, MAX_NAME_LENGTH - 1);
         p->player_name[MAX_NAME_LENGTH - 1] = '\0';
 
-        int grid_rows = (int)ceil(sqrt(num_players));
-        if (grid_rows < 1)
-            grid_rows = 1;
-        int grid_cols = (int)ceil((double)num_players / grid_rows);
-        if (grid_cols < 1)
-            grid_cols = num_players;
-
-        int row = i / grid_cols;
-        int col = i % grid_cols;
-
-        unsigned short px = (unsigned short)(((col + 1) * (long)state->board_width) / (grid_cols + 1));
-        unsigned short py = (unsigned short)(((row + 1) * (long)state->board_height) / (grid_rows + 1));
-        if (px >= state->board_width)
-            px = state->board_width - 1;
-        if (py >= state->board_height)
-            py = state->board_height - 1;
-
-        p->pos_x = px;
-        p->pos_y = py;
+        board_start_position(i, num_players, state->board_width, state->board_height, &hot->pos_x, &hot->pos_y);
         p->pid = 0; // se asignará luego del fork
-        p->is_blocked = false;
+        hot->is_blocked = false;
     }
     
+    if (board_cells != NULL)
+    {
+        // Tablero precalculado: una copia desde el page cache y luego marcar posiciones iniciales
+        if (board_stride(state->board_width) == state->board_width)
+        {
+            memcpy(state->board, board_cells, (size_t)state->board_width * state->board_height * sizeof(int));
+        }
+        else
+        {
+            for (unsigned short y = 0; y < state->board_height; ++y)
+            {
+                memcpy(&BOARD_CELL(state, 0, y), &board_cells[(size_t)y * state->board_width], state->board_width * sizeof(int));
+            }
+        }
+        for (int k = 0; k < state->player_count; ++k)
+        {
+            BOARD_CELL(state, PLAYER_HOT(state, k)->pos_x, PLAYER_HOT(state, k)->pos_y) = -k;
+        }
+        return;
+    }
+
     // Inicializar tablero con recompensas aleatorias (y marcar posiciones iniciales de jugadores)
     srand(seed);
     for (unsigned short y = 0; y < state->board_height; ++y)
@@ -157,7 +279,7 @@ void initialize_game_state(game_state_t *state, char *player_paths[MAX_PLAYERS],
             int found_idx = -1;
             for (int k = 0; k < state->player_count; ++k)
             {
-                if (state->players[k].pos_x == x && state->players[k].pos_y == y)
+                if (PLAYER_HOT(state, k)->pos_x == x && PLAYER_HOT(state, k)->pos_y == y)
                 {
                     found_idx = k;
                     break;
@@ -166,19 +288,28 @@ void initialize_game_state(game_state_t *state, char *player_paths[MAX_PLAYERS],
             if (found_idx >= 0)
             {
                 // Celda ocupada inicialmente por jugador found_idx
-                state->board[y * state->board_width + x] = -found_idx;
+                BOARD_CELL(state, x, y) = -found_idx;
             }
             else
             {
                 // Celda libre: asignar recompensa aleatoria 1-9
-                state->board[y * state->board_width + x] = (rand() % 9) + 1;
+                BOARD_CELL(state, x, y) = (rand() % 9) + 1;
             }
         }
     }
 }
 
 
-int create_player_processes(game_state_t *state, game_sync_t *game_sync, char *player_paths[], int num_players, int pipe_fds[][2], pid_t player_pids[]) {
+void apply_master_placement(const master_options_t *opts) {
+    if (opts->master_cpus_set && apply_cpu_affinity(0, &opts->master_cpus) != 0) {
+        fprintf(stderr, "Advertencia: no se pudo fijar la afinidad del master\n");
+    }
+    if (apply_sched_policy(&opts->master_sched) != 0) {
+        fprintf(stderr, "Advertencia: no se pudo aplicar la política de planificación del master\n");
+    }
+}
+
+int create_player_processes(game_state_t *state, game_sync_t *game_sync, game_ext_t *ext, char *player_paths[], int num_players, int pipe_fds[][2], pid_t player_pids[], const master_options_t *opts) {
     for (int i = 0; i < num_players; ++i)
     {
         if (pipe(pipe_fds[i]) == -1)
@@ -193,11 +324,16 @@ int create_player_processes(game_state_t *state, game_sync_t *game_sync, char *p
                 int st;
                 waitpid(player_pids[j], &st, 0);
             }
-            cleanup_resources(state, game_sync, pipe_fds, i);
+            cleanup_resources(state, game_sync, ext, pipe_fds, i);
             return -1;
         }
         fcntl(pipe_fds[i][0], F_SETFD, FD_CLOEXEC);
         fcntl(pipe_fds[i][1], F_SETFD, FD_CLOEXEC);
+
+        // El cgroup lo crea el master, que es quien lo elimina al final
+        char cgroup_path[4096];
+        bool has_cgroup = player_cgroup_path(&opts->player_limits, i, cgroup_path, sizeof(cgroup_path)) == 0 &&
+                          player_cgroup_create(&opts->player_limits, cgroup_path) == 0;
         
         pid_t pid = fork();
         if (pid < 0)
@@ -213,7 +349,7 @@ int create_player_processes(game_state_t *state, game_sync_t *game_sync, char *p
                 int st;
                 waitpid(player_pids[j], &st, 0);
             }
-            cleanup_resources(state, game_sync, pipe_fds, i);
+            cleanup_resources(state, game_sync, ext, pipe_fds, i);
             return -1;
         }
         
@@ -227,6 +363,13 @@ int create_player_processes(game_state_t *state, game_sync_t *game_sync, char *p
             char w_arg[16], h_arg[16];
             snprintf(w_arg, sizeof(w_arg), "%hu", state->board_width);
             snprintf(h_arg, sizeof(h_arg), "%hu", state->board_height);
+
+            // La afinidad se hereda a través de execl
+            if (opts->player_cpu_sets > 0) {
+                apply_cpu_affinity(0, &opts->player_cpus[i % opts->player_cpu_sets]);
+            }
+            // Los límites también se heredan: se aplican justo antes de cambiar de programa
+            apply_player_limits(&opts->player_limits, has_cgroup ? cgroup_path : NULL);
             
             execl(player_paths[i], player_paths[i], w_arg, h_arg, (char *)NULL);
             fprintf(stderr, "Error: no se pudo ejecutar %s: %s\n", player_paths[i], strerror(errno));
@@ -242,7 +385,7 @@ int create_player_processes(game_state_t *state, game_sync_t *game_sync, char *p
     return 0;
 }
 
-pid_t create_view_process(game_state_t *state, game_sync_t *game_sync, char *view_path, unsigned short width, unsigned short height) {
+pid_t create_view_process(game_state_t *state, game_sync_t *game_sync, char *view_path, unsigned short width, unsigned short height, const master_options_t *opts) {
     if (view_path == NULL) {
         return -1; 
     }
@@ -258,6 +401,9 @@ pid_t create_view_process(game_state_t *state, game_sync_t *game_sync, char *vie
         char w_arg[16], h_arg[16];
         snprintf(w_arg, sizeof w_arg, "%hu", width);
         snprintf(h_arg, sizeof h_arg, "%hu", height);
+        if (opts->view_cpus_set) {
+            apply_cpu_affinity(0, &opts->view_cpus);
+        }
         execl(view_path, view_path, w_arg, h_arg, (char *)NULL);
         fprintf(stderr, "Error: no se pudo ejecutar vista %s: %s\n", view_path, strerror(errno));
         _exit(127);
@@ -291,115 +437,148 @@ long calculate_remaining_time(time_t last_valid_time, unsigned int timeout_s) {
     return (long)timeout_s - elapsed;
 }
 
-int configure_fd_set(fd_set *readfds, int pipe_fds[][2], int num_players) {
-    FD_ZERO(readfds);
-    int maxfd = -1;
-    for (int i = 0; i < num_players; ++i) {
-        if (pipe_fds[i][0] >= 0) {
-            FD_SET(pipe_fds[i][0], readfds);
-            if (pipe_fds[i][0] > maxfd) {
-                maxfd = pipe_fds[i][0];
-            }
-        }
+// Cuenta un movimiento inválido y lo publica para los observadores
+static bool reject_move(game_state_t *state, game_ext_t *ext, int player_idx) {
+    player_hot_t *player = PLAYER_HOT(state, player_idx);
+    player->invalid_moves++;
+    if (ext != NULL) {
+        uint32_t cell = (uint32_t)player->pos_y * state->board_width + player->pos_x;
+        event_ring_publish(&ext->events, EVENT_INVALID, (uint8_t)player_idx, cell, cell, 0);
     }
-    return maxfd;
+    return false;
 }
 
-int search_pipe_ready(fd_set *readfds, int pipe_fds[][2], int num_players, int *start_index) {
-    for (int j = 0; j < num_players; ++j) {
-        int idx = (*start_index + j) % num_players;
-        if (pipe_fds[idx][0] >= 0 && FD_ISSET(pipe_fds[idx][0], readfds)) {
-            *start_index = (idx + 1) % num_players;
-            return idx;
-        }
-    }
-    return -1;
-}
+bool process_player_move(game_state_t *state, game_ext_t *ext, int player_idx, unsigned char direction, const int dir_offsets[8][2]) {
+    player_hot_t *player = PLAYER_HOT(state, player_idx);
 
-bool process_player_move(game_state_t *state, int player_idx, unsigned char direction, const int dir_offsets[8][2]) {
-    
-    if(state->players[player_idx].is_blocked) {
+    if(player->is_blocked) {
         return false;
     }
     
     if (direction > 7) {
         // Movimiento fuera de rango
-        state->players[player_idx].invalid_moves++;
-        return false;
+        return reject_move(state, ext, player_idx);
     }
     
-    short dx = dir_offsets[direction][0];
-    short dy = dir_offsets[direction][1];
-    int cur_x = state->players[player_idx].pos_x;
-    int cur_y = state->players[player_idx].pos_y;
-    int new_x = cur_x + dx;
-    int new_y = cur_y + dy;
+    int new_x = player->pos_x + dir_offsets[direction][0];
+    int new_y = player->pos_y + dir_offsets[direction][1];
     
-    if (new_x < 0 || new_x >= state->board_width || new_y < 0 || new_y >= state->board_height) {
-        // Se intenta salir del tablero
-        state->players[player_idx].invalid_moves++;
-        return false;
+    if (BOARD_NEEDS_BOUNDS_CHECK && !board_in_bounds(state, new_x, new_y)) {
+        // Se intenta salir del tablero (con borde centinela lo resuelve la comparación de abajo)
+        return reject_move(state, ext, player_idx);
     }
     
-    int target_val = state->board[new_y * state->board_width + new_x];
+    size_t target = board_index_stride(board_stride(state->board_width), new_x, new_y);
+    int target_val = state->board[target];
     if (target_val <= 0) {
-        state->players[player_idx].invalid_moves++;
-        return false;
+        return reject_move(state, ext, player_idx);
     }
     
     // Movimiento válido
-    state->players[player_idx].valid_moves++;
-    state->players[player_idx].score += (unsigned int)target_val;
-    state->players[player_idx].pos_x = (unsigned short)new_x;
-    state->players[player_idx].pos_y = (unsigned short)new_y;
-    state->board[new_y * state->board_width + new_x] = -(int)player_idx;
+    uint32_t old_cell = (uint32_t)player->pos_y * state->board_width + player->pos_x;
+    player->valid_moves++;
+    player->score += (unsigned int)target_val;
+    player->pos_x = (unsigned short)new_x;
+    player->pos_y = (unsigned short)new_y;
+    state->board[target] = -(int)player_idx;
+
+    if (ext != NULL) {
+        uint32_t new_cell = (uint32_t)new_y * state->board_width + (uint32_t)new_x;
+        change_log_append(&ext->change_log, new_cell, -(int)player_idx);
+        event_ring_publish(&ext->events, EVENT_MOVE, (uint8_t)player_idx, old_cell, new_cell, target_val);
+        ext->board_hash ^= zobrist_cell_key(new_cell, target_val) ^ zobrist_cell_key(new_cell, -(int)player_idx) ^
+                           zobrist_player_key((unsigned int)player_idx, old_cell) ^ zobrist_player_key((unsigned int)player_idx, new_cell);
+        free_bitmap_clear(ext, new_x, new_y);
+        reward_index_add(ext, new_x, new_y, -(int64_t)target_val);
+    }
     
     return true;
 }
 
-void update_lock_status(game_state_t *state, const int DIR_OFFSETS[8][2], bool move_valid) {
+void block_player(game_state_t *state, game_ext_t *ext, int player_idx) {
+    player_hot_t *player = PLAYER_HOT(state, player_idx);
+    if (player->is_blocked) {
+        return;
+    }
+    player->is_blocked = true;
+    if (ext != NULL) {
+        uint32_t cell = (uint32_t)player->pos_y * state->board_width + player->pos_x;
+        event_ring_publish(&ext->events, EVENT_BLOCKED, (uint8_t)player_idx, cell, cell, 0);
+    }
+}
+
+void update_lock_status(game_state_t *state, game_ext_t *ext, const int DIR_OFFSETS[8][2], bool move_valid) {
+    if (!move_valid) {
+        return;
+    }
+
+    ptrdiff_t neighbor[8];
+    board_neighbor_offsets(state, DIR_OFFSETS, neighbor);
+    size_t stride = board_stride(state->board_width);
+
     for (int i = 0; i < state->player_count; ++i) {
-        if (move_valid && !state->players[i].is_blocked) {
-            bool any_free = false;
-            for (int d = 0; d < 8; ++d) {
-                int nx = state->players[i].pos_x + DIR_OFFSETS[d][0];
-                int ny = state->players[i].pos_y + DIR_OFFSETS[d][1];
-                if (nx >= 0 && nx < state->board_width && ny >= 0 && ny < state->board_height) {
-                    if (state->board[ny * state->board_width + nx] > 0) {
-                        any_free = true;
-                        break;
-                    }
-                }
-            }
-            if (!any_free) {
-                state->players[i].is_blocked = true;
+        player_hot_t *player = PLAYER_HOT(state, i);
+        if (player->is_blocked) {
+            continue;
+        }
+        size_t cur = board_index_stride(stride, player->pos_x, player->pos_y);
+        bool any_free = false;
+        for (int d = 0; d < 8 && !any_free; ++d) {
+            if (BOARD_NEEDS_BOUNDS_CHECK &&
+                !board_in_bounds(state, player->pos_x + DIR_OFFSETS[d][0], player->pos_y + DIR_OFFSETS[d][1])) {
+                continue;
             }
+            any_free = state->board[cur + neighbor[d]] > 0;
+        }
+        if (!any_free) {
+            block_player(state, ext, i);
         }
     }
 }
 
 bool all_players_blocked(game_state_t *state) {
     for (int k = 0; k < state->player_count; ++k) {
-        if (!state->players[k].is_blocked) {
+        if (!PLAYER_HOT(state, k)->is_blocked) {
             return false;
         }
     }
     return true;
 }
 
-bool handle_move_aftermath(game_state_t *state, game_sync_t *game_sync, bool has_view, int pipe_fds[][2], int i, bool move_valid, unsigned int delay_ms, bool all_blocked_flag, time_t *last_valid_time) {
+void grant_initial_credits(game_sync_t *game_sync, response_monitor_t *monitor, int num_players, unsigned int credit_depth) {
+    if (credit_depth == 0) {
+        credit_depth = DEFAULT_CREDIT_DEPTH;
+    }
+    for (int i = 0; i < num_players; ++i) {
+        for (unsigned int c = 0; c < credit_depth; ++c) {
+            if (monitor != NULL) {
+                response_monitor_grant(monitor, i);
+            }
+            allow_player_move(game_sync, i);
+        }
+    }
+}
+
+bool handle_move_aftermath(game_state_t *state, game_sync_t *game_sync, bool has_view, int pipe_fds[][2], int i, bool move_valid, unsigned int credits, response_monitor_t *monitor, unsigned int delay_ms, bool all_blocked_flag, time_t *last_valid_time) {
     // Actualizar temporizador de último movimiento válido
     if (move_valid) {
         *last_valid_time = time(NULL);
     }
     
-    // Notificar a TODOS los jugadores listos
-    for (int p = 0; p < state->player_count; ++p) {
-        if (pipe_fds[p][0] >= 0 && !state->players[p].is_blocked) {
-            allow_player_move(game_sync, p);
+    // Reponer sólo los créditos consumidos por este jugador
+    if (pipe_fds[i][0] >= 0 && !PLAYER_HOT(state, i)->is_blocked) {
+        for (unsigned int c = 0; c < credits; ++c) {
+            if (monitor != NULL) {
+                response_monitor_grant(monitor, i);
+            }
+            allow_player_move(game_sync, i);
         }
     }
     
+    // La espera a la vista y la demora son del master: no cuentan como tiempo de respuesta
+    if (monitor != NULL) {
+        response_monitor_pacing_begin(monitor);
+    }
     if (has_view) {
         notify_view(game_sync);
         wait_view_done(game_sync);
@@ -408,19 +587,110 @@ bool handle_move_aftermath(game_state_t *state, game_sync_t *game_sync, bool has
     if (delay_ms > 0) {
         usleep(delay_ms * 1000);
     }
+    if (monitor != NULL) {
+        response_monitor_pacing_end(monitor);
+    }
     
     return !all_blocked_flag;
 }
 
-int finalize_game(game_state_t *state, game_sync_t *game_sync, bool has_view, pid_t view_pid, int pipe_fds[][2], pid_t player_pids[], int num_players) {
-    
+int compute_winner(const game_state_t *state) {
+    int winner_idx = 0;
+    for (int j = 1; j < state->player_count; ++j) {
+        const player_hot_t *p = PLAYER_HOT(state, j);
+        const player_hot_t *best = PLAYER_HOT(state, winner_idx);
+        if (p->score > best->score) {
+            winner_idx = j;
+        } else if (p->score == best->score) {
+            if (p->valid_moves < best->valid_moves) {
+                winner_idx = j;
+            } else if (p->valid_moves == best->valid_moves) {
+                if (p->invalid_moves < best->invalid_moves) {
+                    winner_idx = j;
+                }
+            }
+        }
+    }
+    return winner_idx;
+}
+
+// Territorio de cada jugador y lo que quedó libre en el tablero
+static void print_board_stats(const game_state_t *state) {
+    board_stats_t stats;
+    board_stats_compute(state, &stats);
+    printf("Board: %lu free cells, %llu remaining reward\n", stats.free_cells, stats.remaining_reward);
+    printf("Territory:");
+    for (unsigned int i = 0; i < state->player_count; ++i) {
+        printf("%s %s %u = %lu cells", i == 0 ? "" : ",", state->players[i].player_name, i, stats.owned[i]);
+    }
+    printf("\n");
+}
+
+static void print_player_result(const game_state_t *state, int i, const reap_target_t *target, const player_limits_t *limits) {
+    const player_hot_t *p = PLAYER_HOT(state, i);
+    char cgroup_path[4096];
+    bool has_cgroup = limits != NULL && player_cgroup_path(limits, i, cgroup_path, sizeof(cgroup_path)) == 0;
+    const char *violation = NULL;
+    if (target->usage.collected) {
+        violation = player_limit_violation(limits, has_cgroup ? cgroup_path : NULL, target->status, &target->usage.usage,
+                                           target->last_signal);
+    }
+
+    if (!target->usage.collected) {
+        printf("Player %s (%d) did not exit", state->players[i].player_name, i);
+    } else if (violation != NULL) {
+        printf("Player %s (%d) exceeded its %s (signal %d)", state->players[i].player_name, i, violation, WTERMSIG(target->status));
+    } else if (WIFSIGNALED(target->status)) {
+        printf("Player %s (%d) terminated by signal (%d)", state->players[i].player_name, i, WTERMSIG(target->status));
+    } else {
+        printf("Player %s (%d) exited (%d)", state->players[i].player_name, i, WEXITSTATUS(target->status));
+    }
+    printf(" with a score of %u / %u valid moves / %u invalid moves\n", p->score, p->valid_moves, p->invalid_moves);
+
+    if (has_cgroup) {
+        player_cgroup_remove(cgroup_path);
+    }
+}
+
+// Resultado de un proceso auxiliar (vista o servidor de espectadores)
+static void print_helper_result(const char *name, const reap_target_t *target) {
+    if (!target->usage.collected) {
+        printf("%s did not exit\n", name);
+    } else if (WIFEXITED(target->status)) {
+        printf("%s exited (%d)\n", name, WEXITSTATUS(target->status));
+    } else if (WIFSIGNALED(target->status)) {
+        printf("%s terminated by signal (%d)\n", name, WTERMSIG(target->status));
+    } else {
+        printf("%s terminated abnormally\n", name);
+    }
+}
+
+int finalize_game(game_state_t *state, game_sync_t *game_sync, game_ext_t *ext, bool has_view, pid_t view_pid, pid_t spectator_pid, int pipe_fds[][2], pid_t player_pids[], int num_players, const response_monitor_t *monitor, const player_limits_t *limits, unsigned int shutdown_ms) {
+    if (shutdown_ms == 0) {
+        shutdown_ms = DEFAULT_SHUTDOWN_MS;
+    }
+
     writer_enter(game_sync);
     state->game_over = true;
+    if (ext != NULL) {
+        event_ring_publish(&ext->events, EVENT_GAME_OVER, 0, 0, 0, 0);
+    }
     writer_exit(game_sync);
     
     if (has_view) {
+        // La vista puede estar trabada (por ejemplo, en getch()): no esperarla más allá del plazo
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += shutdown_ms / 1000;
+        deadline.tv_nsec += (long)(shutdown_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
         notify_view(game_sync);
-        wait_view_done(game_sync);
+        if (!wait_view_done_until(game_sync, &deadline)) {
+            fprintf(stderr, "Advertencia: la vista no respondió en %u ms\n", shutdown_ms);
+        }
     }
     
     // Despertar a los jugadores que puedan estar esperando
@@ -430,50 +700,66 @@ int finalize_game(game_state_t *state, game_sync_t *game_sync, bool has_view, pi
         }
     }
 
-    // Esperar a que terminen los procesos y mostrar resultados
-    if (has_view) {
-        int status;
-        waitpid(view_pid, &status, 0);
-        
-        if (WIFEXITED(status)) {
-            printf("View exited (%d)\n", WEXITSTATUS(status));
-        }
-        else if (WIFSIGNALED(status)) {
-            printf("View terminated by signal (%d)\n", WTERMSIG(status));
-        }
-        else {
-            printf("View terminated abnormally\n");
+    // Cerrar los extremos de lectura: un jugador bloqueado escribiendo en un pipe lleno recibe EPIPE
+    for (int i = 0; i < num_players; ++i) {
+        if (pipe_fds[i][0] >= 0) {
+            close(pipe_fds[i][0]);
+            pipe_fds[i][0] = -1;
         }
     }
 
-    // Esperar a cada proceso jugador y mostrar sus estadísticas
-    int winner_idx = 0;
+    // Recolectar a la vista, al servidor de espectadores y a los jugadores a la vez, con plazo y escalamiento SIGTERM -> SIGKILL
+    reap_target_t targets[MAX_PLAYERS + 2];
+    int target_count = 0;
     for (int i = 0; i < num_players; ++i) {
-        int player_status;
-        waitpid(player_pids[i], &player_status, 0);
-        printf("Player %s (%d) exited (%d) with a score of %u / %u valid moves / %u invalid moves\n",
-            state->players[i].player_name, i, WEXITSTATUS(player_status),
-            state->players[i].score,
-            state->players[i].valid_moves,
-            state->players[i].invalid_moves);
-
-        for (int j = 1; j < num_players; ++j) {
-            if (state->players[j].score > state->players[winner_idx].score) {
-                winner_idx = j;
-            } else if (state->players[j].score == state->players[winner_idx].score) {
-                if (state->players[j].valid_moves < state->players[winner_idx].valid_moves) {
-                    winner_idx = j;
-                } else if (state->players[j].valid_moves == state->players[winner_idx].valid_moves) {
-                    if (state->players[j].invalid_moves < state->players[winner_idx].invalid_moves) {
-                        winner_idx = j;
-                    }
-                }
-            }
+        char label[sizeof(targets[0].usage.label)];
+        snprintf(label, sizeof(label), "player %s %d", state->players[i].player_name, i);
+        reap_target_init(&targets[target_count++], player_pids[i], label);
+    }
+    int view_idx = -1, spectator_idx = -1;
+    if (has_view) {
+        view_idx = target_count;
+        reap_target_init(&targets[target_count++], view_pid, "view");
+    }
+    if (spectator_pid > 0) {
+        spectator_idx = target_count;
+        reap_target_init(&targets[target_count++], spectator_pid, "spectator");
+    }
+    reap_processes(targets, target_count, shutdown_ms, SHUTDOWN_TERM_MS);
+
+    // Mostrar resultados
+    if (view_idx >= 0) {
+        print_helper_result("View", &targets[view_idx]);
+    }
+    if (spectator_idx >= 0) {
+        print_helper_result("Spectator server", &targets[spectator_idx]);
+    }
+
+    process_usage_t usage[MAX_PLAYERS + 2];
+    int usage_count = 0;
+    if (view_idx >= 0) {
+        usage[usage_count++] = targets[view_idx].usage;
+    }
+    if (spectator_idx >= 0) {
+        usage[usage_count++] = targets[spectator_idx].usage;
+    }
+    for (int i = 0; i < num_players; ++i) {
+        print_player_result(state, i, &targets[i], limits);
+        if (monitor != NULL) {
+            response_monitor_print(monitor, i);
         }
+        usage[usage_count++] = targets[i].usage;
     }
+    int winner_idx = compute_winner(state);
     printf("The winner is: %s %d\n", state->players[winner_idx].player_name, winner_idx);
+    if (ext != NULL) {
+        printf("Final board hash: %016llx\n", (unsigned long long)ext->board_hash);
+    }
+    print_board_stats(state);
+    print_usage_report(usage, usage_count);
 
-    cleanup_resources(state, game_sync, pipe_fds, num_players);
+    // Las memorias compartidas y los semáforos se liberan aunque algún hijo no se haya podido recolectar
+    cleanup_resources(state, game_sync, ext, pipe_fds, num_players);
     
     return EXIT_SUCCESS;
 }
@@ -506,3 +792,28 @@ int check_game_sync(game_sync_t *game_sync, game_state_t *state, unsigned short
     }
     return 0;
 }
+
+int check_game_ext(game_ext_t *ext, game_sync_t *game_sync, game_state_t *state, unsigned short width, unsigned short height) {
+    if (ext == NULL) {
+        fprintf(stderr, "Error creating game ext\n");
+        cleanup_semaphores(game_sync, MAX_PLAYERS);
+        close_game_sync(game_sync);
+        close_game_state(state, width, height);
+        shm_unlink("/game_state");
+        shm_unlink("/game_sync");
+        return -1;
+    }
+    if (ext->lock_mode == LOCK_MODE_ROBUST) {
+        sync_use_robust_lock(&ext->robust_lock);
+    }
+    return 0;
+}
+
+void publish_game_ext(game_ext_t *ext, const game_state_t *state) {
+    if (ext == NULL) {
+        return;
+    }
+    ext->board_hash = zobrist_hash_state(state);
+    free_bitmap_build(ext, state);
+    reward_index_build(ext, state);
+}
@@ -15,28 +15,82 @@
 #include <math.h>
 #include "shared_memory.h"
 #include "sync_utils.h"
+#include "board_access.h"
+#include "board_file.h"
+#include "sched_utils.h"
+#include "input_sched.h"
+#include "response_monitor.h"
+#include "reap_utils.h"
+#include "zobrist.h"
+#include "free_bitmap.h"
+#include "reward_index.h"
+#include "board_stats.h"
+#include "spectator_server.h"
+#include "control.h"
 #include <fcntl.h> 
 
+// Opciones adicionales del master
+#define DEFAULT_CREDIT_DEPTH 1
+#define MAX_CREDIT_DEPTH 64
+
+typedef struct {
+    char *board_path;                     // -b: archivo de tablero precalculado (NULL para generarlo a partir de la semilla)
+    bool master_cpus_set;                 // -a: CPUs del master
+    cpu_set_t master_cpus;
+    int player_cpu_sets;                  // -A: conjuntos de CPUs de los jugadores, asignados en forma circular
+    cpu_set_t player_cpus[MAX_PLAYERS];
+    bool view_cpus_set;                   // -V: CPUs de la vista
+    cpu_set_t view_cpus;
+    sched_policy_t master_sched;          // -r: política de planificación del master
+    unsigned int lock_mode;               // -l: LOCK_MODE_SEM o LOCK_MODE_ROBUST
+    unsigned int credit_depth;            // -k: movimientos que cada jugador puede tener pendientes (0 = DEFAULT_CREDIT_DEPTH)
+    input_sched_config_t input;           // -q, -o, -W: planificación de la entrada de los jugadores
+    eviction_policy_t eviction;           // -E: expulsión de jugadores lentos
+    unsigned int shutdown_ms;             // -x: plazo de terminación de los hijos (0 = DEFAULT_SHUTDOWN_MS)
+    char *spectator_path;                 // -S: socket de espectadores (NULL = sin servidor)
+    char *control_path;                   // -C: socket de control (NULL = sin control)
+    player_limits_t player_limits;        // -R: límites de recursos de cada jugador
+} master_options_t;
+
 // Función para parsear argumentos del master
-int parse_arguments(int argc, char *argv[], unsigned short *width, unsigned short *height, unsigned int *delay_ms, unsigned int *timeout_s, unsigned int *seed, char **view_path, char *player_paths[], int *num_players);
+int parse_arguments(int argc, char *argv[], unsigned short *width, unsigned short *height, unsigned int *delay_ms, unsigned int *timeout_s, unsigned int *seed, char **view_path, char *player_paths[], int *num_players, master_options_t *opts);
 
-void cleanup_resources(game_state_t *state, game_sync_t *sync, int pipe_fds[][2], int num_players);
+void cleanup_resources(game_state_t *state, game_sync_t *sync, game_ext_t *ext, int pipe_fds[][2], int num_players);
+
+/**
+ * Abre un archivo de tablero y toma de él las dimensiones del juego.
+ * 
+ * @param path Ruta al archivo de tablero
+ * @param bf Estructura donde se guarda el mapeo del archivo
+ * @param width Ancho del tablero (se sobreescribe con el del archivo)
+ * @param height Alto del tablero (se sobreescribe con el del archivo)
+ * 
+ * @return 0 en caso de éxito, -1 en caso de error
+ */
+int load_board_file(const char *path, board_file_t *bf, unsigned short *width, unsigned short *height);
 
-void initialize_game_state(game_state_t *state, char *player_paths[MAX_PLAYERS], int num_players, unsigned int seed);
+/**
+ * Inicializa jugadores y tablero.
+ * 
+ * @param board_cells Celdas precalculadas (de un archivo de tablero) o NULL para generarlas con la semilla
+ */
+void initialize_game_state(game_state_t *state, char *player_paths[MAX_PLAYERS], int num_players, unsigned int seed, const int *board_cells);
 
 /**
  * Crea los procesos jugador y configura sus pipes.
  * 
  * @param state Puntero al estado del juego
  * @param game_sync Puntero a la estructura de sincronización
+ * @param ext Puntero a las extensiones (/game_ext)
  * @param player_paths Array de rutas a los ejecutables de los jugadores
  * @param num_players Número de jugadores
  * @param pipe_fds Array bidimensional donde se almacenarán los descriptores de los pipes
  * @param player_pids Array donde se almacenarán los PIDs de los procesos jugador
+ * @param opts Opciones del master (afinidad de CPU de los jugadores)
  * 
  * @return 0 en caso de éxito, -1 en caso de error
  */
-int create_player_processes(game_state_t *state, game_sync_t *game_sync, char *player_paths[], int num_players, int pipe_fds[][2], pid_t player_pids[]);
+int create_player_processes(game_state_t *state, game_sync_t *game_sync, game_ext_t *ext, char *player_paths[], int num_players, int pipe_fds[][2], pid_t player_pids[], const master_options_t *opts);
 
 /**
  * Crea el proceso de vista si se especificó una ruta válida.
@@ -46,42 +100,75 @@ int create_player_processes(game_state_t *state, game_sync_t *game_sync, char *p
  * @param view_path Ruta al ejecutable de vista (NULL si no se usa vista)
  * @param width Ancho del tablero
  * @param height Alto del tablero
+ * @param opts Opciones del master (afinidad de CPU de la vista)
  * 
  * @return PID del proceso vista si se creó correctamente, -1 en caso contrario
  */
-pid_t create_view_process(game_state_t *state, game_sync_t *game_sync, char *view_path, unsigned short width, unsigned short height);
+pid_t create_view_process(game_state_t *state, game_sync_t *game_sync, char *view_path, unsigned short width, unsigned short height, const master_options_t *opts);
 
-long calculate_remaining_time(time_t last_valid_time, unsigned int timeout_s);
+/**
+ * Aplica afinidad de CPU y política de planificación al propio master. Se llama después de crear todos
+ * los hijos, para que no hereden ni la afinidad ni el nice.
+ * Un fallo (por ejemplo, falta de permisos para tiempo real) no es fatal.
+ */
+void apply_master_placement(const master_options_t *opts);
 
-int configure_fd_set(fd_set *readfds, int pipe_fds[][2], int num_players);
+long calculate_remaining_time(time_t last_valid_time, unsigned int timeout_s);
 
 /**
  * Procesa el movimiento de un jugador y actualiza el estado del juego.
  * 
  * @param state Puntero al estado del juego
+ * @param ext Extensiones donde se publica el cambio del tablero (puede ser NULL)
  * @param player_idx Índice del jugador que realiza el movimiento
  * @param direction Dirección del movimiento (0-7)
  * @param dir_offsets Matriz de desplazamientos para cada dirección
  * 
  * @return true si el movimiento fue válido, false en caso contrario
  */
-bool process_player_move(game_state_t *state, int player_idx, unsigned char direction, const int dir_offsets[8][2]);
+bool process_player_move(game_state_t *state, game_ext_t *ext, int player_idx, unsigned char direction, const int dir_offsets[8][2]);
+
+/**
+ * Marca como bloqueados a los jugadores que ya no tienen celdas libres alrededor.
+ *
+ * @param state Puntero al estado del juego
+ * @param ext Extensiones donde se publica cada bloqueo (puede ser NULL)
+ * @param DIR_OFFSETS Matriz de desplazamientos para cada dirección
+ * @param move_valid Si el último movimiento fue válido (si no, el tablero no cambió y no hay nada que revisar)
+ */
+void update_lock_status(game_state_t *state, game_ext_t *ext, const int DIR_OFFSETS[8][2], bool move_valid);
 
-void update_lock_status(game_state_t *state, const int DIR_OFFSETS[8][2], bool move_valid);
+// Bloquea al jugador (EOF, expulsión) y publica el evento. Se llama dentro de writer_enter/writer_exit.
+void block_player(game_state_t *state, game_ext_t *ext, int player_idx);
 
 // Parámetros: state
 // Retorna: true si todos están bloqueados, false si no
 bool all_players_blocked(game_state_t *state);
 
+/**
+ * Otorga a cada jugador sus créditos iniciales: credit_depth posts de player_move_sem. A partir de ahí
+ * cada jugador recibe un crédito nuevo sólo cuando el master consume uno de sus movimientos, por lo que
+ * nunca tiene más de credit_depth movimientos pendientes.
+ * 
+ * @param game_sync Estructura de sincronización
+ * @param monitor Monitor de tiempos de respuesta (puede ser NULL)
+ * @param num_players Cantidad de jugadores
+ * @param credit_depth Créditos por jugador (0 = DEFAULT_CREDIT_DEPTH)
+ */
+void grant_initial_credits(game_sync_t *game_sync, response_monitor_t *monitor, int num_players, unsigned int credit_depth);
+
 /**
  * Maneja las operaciones posteriores al procesamiento de un movimiento.
- * Actualiza temporizadores, notifica a jugadores y vista, y gestiona delays.
+ * Actualiza temporizadores, repone el crédito del jugador cuyo movimiento se consumió (sólo a él, si
+ * sigue activo), notifica a la vista y gestiona delays.
  * 
  * @param game_sync Estructura de sincronización
  * @param has_view Indica si hay un proceso de vista activo
  * @param pipe_fds Array de descriptores de pipes de los jugadores
  * @param i Índice del jugador actual
  * @param move_valid Indica si el movimiento fue válido
+ * @param credits Créditos a reponer al jugador i (movimientos consumidos de su pipe)
+ * @param monitor Monitor de tiempos de respuesta (puede ser NULL)
  * @param delay_ms Tiempo de espera entre movimientos (ms)
  * @param all_blocked_flag Puntero a la bandera que indica si todos los jugadores están bloqueados
  * @param last_valid_time Puntero al tiempo del último movimiento válido
@@ -89,25 +176,46 @@ bool all_players_blocked(game_state_t *state);
  * @return true si se debe continuar el juego, false si se debe terminar
  */
 //bool handle_move_aftermath(game_sync_t *game_sync, bool has_view, int pipe_fds[][2], int i, bool move_valid, unsigned int delay_ms, bool all_blocked_flag, time_t *last_valid_time);
-bool handle_move_aftermath(game_state_t *state, game_sync_t *game_sync, bool has_view, int pipe_fds[][2], int i, bool move_valid, unsigned int delay_ms, bool all_blocked_flag, time_t *last_valid_time);
+bool handle_move_aftermath(game_state_t *state, game_sync_t *game_sync, bool has_view, int pipe_fds[][2], int i, bool move_valid, unsigned int credits, response_monitor_t *monitor, unsigned int delay_ms, bool all_blocked_flag, time_t *last_valid_time);
+
+/**
+ * Calcula el ganador: mayor puntaje, luego menos movimientos válidos y luego menos inválidos.
+ * 
+ * @return Índice del jugador ganador
+ */
+int compute_winner(const game_state_t *state);
 
 /**
  * Finaliza el juego, notifica a los procesos, muestra resultados y libera recursos.
  * 
  * @param state Estado del juego
  * @param game_sync Estructura de sincronización
+ * @param ext Extensiones (/game_ext)
  * @param has_view Indica si hay un proceso de vista activo
  * @param view_pid PID del proceso vista (si existe)
+ * @param spectator_pid PID del servidor de espectadores (-1 si no hay)
  * @param pipe_fds Array de descriptores de pipes de los jugadores
  * @param player_pids Array de PIDs de los procesos jugador
  * @param num_players Número de jugadores
+ * @param monitor Tiempos de respuesta a imprimir junto a cada jugador (puede ser NULL)
+ * @param limits Límites de los jugadores, para informar quién terminó por excederlos (puede ser NULL)
+ * @param shutdown_ms Plazo para que la vista, el servidor de espectadores y los jugadores terminen solos antes de SIGTERM/SIGKILL (0 = DEFAULT_SHUTDOWN_MS)
  * 
  * @return El código de estado de salida (EXIT_SUCCESS o EXIT_FAILURE)
  */
-int finalize_game(game_state_t *state, game_sync_t *game_sync, bool has_view, pid_t view_pid, int pipe_fds[][2], pid_t player_pids[], int num_players);
+int finalize_game(game_state_t *state, game_sync_t *game_sync, game_ext_t *ext, bool has_view, pid_t view_pid, pid_t spectator_pid, int pipe_fds[][2], pid_t player_pids[], int num_players, const response_monitor_t *monitor, const player_limits_t *limits, unsigned int shutdown_ms);
 
 int check_game_status(game_state_t *state);
 
 int check_game_sync(game_sync_t *game_sync, game_state_t *state, unsigned short width, unsigned short height);
 
-int search_pipe_ready(fd_set *readfds, int pipe_fds[][2], int num_players, int *start_index);
\ No newline at end of file
+int check_game_ext(game_ext_t *ext, game_sync_t *game_sync, game_state_t *state, unsigned short width, unsigned short height);
+
+/**
+ * Calcula los datos de /game_ext derivados del tablero (hash Zobrist, bitmap de celdas libres, índice de recompensas) a partir del estado inicial. Se llama
+ * una vez, luego de initialize_game_state; después process_player_move los mantiene incrementalmente.
+ * 
+ * @param ext Extensiones compartidas (puede ser NULL)
+ * @param state Estado del juego ya inicializado
+ */
+void publish_game_ext(game_ext_t *ext, const game_state_t *state);
\ No newline at end of file
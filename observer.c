@@ -0,0 +1,279 @@
+#include "shared_memory.h"
+#include "sync_utils.h"
+#include "board_access.h"
+#include "event_ring.h"
+#include "clock_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+
+/*
+ * Observador del anillo de eventos de /game_ext (event_ring.h). Se puede lanzar y cortar en cualquier
+ * momento mientras corre el master, y pueden correr varios a la vez: ninguno frena al master.
+ *
+ * Uso: observer [-m stats|record] [-i intervalo_ms]
+ *   stats   cada intervalo imprime eventos recibidos y eventos por segundo (por defecto)
+ *   record  imprime cada evento en una línea
+ *
+ * Arranca copiando el estado bajo reader_enter/reader_exit y desde ahí aplica los eventos a su propia
+ * copia del tablero. Si se atrasa más que el anillo, vuelve a copiar el estado. Al terminar la partida
+ * imprime un resumen por jugador y compara su copia con el tablero del master.
+ */
+
+#define POLL_INTERVAL_US 1000
+#define DEFAULT_REPORT_MS 1000
+
+typedef enum
+{
+    OBSERVER_STATS,
+    OBSERVER_RECORD
+} observer_mode_t;
+
+typedef struct
+{
+    uint32_t cell; // Celda lógica en la que está
+    long long score;
+    unsigned long moves;
+    unsigned long invalid;
+    bool blocked;
+} observed_player_t;
+
+// Variables globales
+game_state_t *game_state = NULL;
+game_sync_t *game_sync = NULL;
+game_ext_t *game_ext = NULL;
+size_t game_state_size = 0;
+volatile sig_atomic_t stop_requested = 0;
+
+static int *replica = NULL;
+static observed_player_t players[MAX_PLAYERS];
+static uint64_t cursor = 0;
+static unsigned long events_seen = 0;
+static unsigned long resyncs = 0;
+static unsigned long mismatches = 0; // Movimientos cuyo origen no coincide con la copia
+
+static const char *const event_names[] = {"?", "move", "invalid", "blocked", "game_over"};
+
+static void cleanup_resources(void)
+{
+    free(replica);
+    replica = NULL;
+    if (game_ext != NULL)
+        sync_release_robust_lock();
+    detach_game(&game_state, game_state_size, &game_sync, &game_ext);
+}
+
+static void signal_handler(int sig)
+{
+    (void)sig;
+    stop_requested = 1;
+}
+
+static void setup_signal_handlers(void)
+{
+    struct sigaction sa;
+    sa.sa_handler = signal_handler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = 0;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+}
+
+static int attach_shared_memory(void)
+{
+    if (attach_game(&game_state, &game_state_size, &game_sync, &game_ext) != 0)
+        return -1;
+    if (game_ext->lock_mode == LOCK_MODE_ROBUST)
+        sync_use_robust_lock(&game_ext->robust_lock);
+
+    replica = malloc((size_t)game_state->board_width * game_state->board_height * sizeof(int));
+    if (replica == NULL)
+    {
+        perror("malloc (copia del tablero)");
+        return -1;
+    }
+    return 0;
+}
+
+// Copia el estado y ubica el cursor en el próximo evento; con el lock de lectura el anillo no avanza
+static void resync_from_snapshot(void)
+{
+    reader_enter(game_sync);
+    const game_state_t *state = game_state;
+    for (unsigned short y = 0; y < state->board_height; ++y)
+        memcpy(&replica[(size_t)y * state->board_width], &BOARD_CELL(state, 0, y), state->board_width * sizeof(int));
+    for (unsigned int i = 0; i < state->player_count && i < MAX_PLAYERS; ++i)
+    {
+        const player_hot_t *hot = PLAYER_HOT(state, i);
+        players[i].cell = (uint32_t)hot->pos_y * state->board_width + hot->pos_x;
+        players[i].score = hot->score;
+        players[i].moves = hot->valid_moves;
+        players[i].invalid = hot->invalid_moves;
+        players[i].blocked = hot->is_blocked;
+    }
+    cursor = event_ring_head(&game_ext->events);
+    reader_exit(game_sync);
+    resyncs++;
+}
+
+static void apply_event(const game_event_t *event)
+{
+    if (event->player >= MAX_PLAYERS)
+        return;
+    observed_player_t *player = &players[event->player];
+    switch (event->kind)
+    {
+    case EVENT_MOVE:
+        if (player->cell != event->from)
+            mismatches++;
+        replica[event->to] = -(int)event->player;
+        player->cell = event->to;
+        player->score += event->score_delta;
+        player->moves++;
+        break;
+    case EVENT_INVALID:
+        player->invalid++;
+        break;
+    case EVENT_BLOCKED:
+        player->blocked = true;
+        break;
+    default:
+        break;
+    }
+}
+
+static void record_event(const game_event_t *event)
+{
+    unsigned short width = game_state->board_width;
+    const char *name = event->kind < sizeof(event_names) / sizeof(event_names[0]) ? event_names[event->kind] : "?";
+    if (event->kind == EVENT_GAME_OVER)
+    {
+        printf("%llu %s\n", (unsigned long long)event->seq, name);
+        return;
+    }
+    printf("%llu %s player=%u from=(%u,%u) to=(%u,%u) delta=%d\n", (unsigned long long)event->seq, name,
+           event->player, event->from % width, event->from / width, event->to % width, event->to / width,
+           event->score_delta);
+}
+
+// Compara la copia con el tablero del master. Retorna la cantidad de celdas distintas.
+static unsigned long verify_replica(void)
+{
+    unsigned long differences = 0;
+    reader_enter(game_sync);
+    for (unsigned short y = 0; y < game_state->board_height; ++y)
+        for (unsigned short x = 0; x < game_state->board_width; ++x)
+            if (replica[(size_t)y * game_state->board_width + x] != BOARD_CELL(game_state, x, y))
+                differences++;
+    reader_exit(game_sync);
+    return differences;
+}
+
+static void print_summary(bool game_over)
+{
+    fprintf(stderr, "observer: %lu events, %lu resyncs, %lu inconsistent moves\n", events_seen, resyncs, mismatches);
+    for (unsigned int i = 0; i < game_state->player_count && i < MAX_PLAYERS; ++i)
+    {
+        fprintf(stderr, "  player %u: score %lld, %lu valid / %lu invalid moves%s\n", i, players[i].score,
+                players[i].moves, players[i].invalid, players[i].blocked ? " [BLOCKED]" : "");
+    }
+    if (game_over)
+    {
+        unsigned long differences = verify_replica();
+        fprintf(stderr, "  replica: %s (%lu cells differ)\n", differences == 0 ? "ok" : "MISMATCH", differences);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    observer_mode_t mode = OBSERVER_STATS;
+    unsigned int report_ms = DEFAULT_REPORT_MS;
+    int opt;
+    while ((opt = getopt(argc, argv, "m:i:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'm':
+            if (strcmp(optarg, "stats") == 0)
+                mode = OBSERVER_STATS;
+            else if (strcmp(optarg, "record") == 0)
+                mode = OBSERVER_RECORD;
+            else
+            {
+                fprintf(stderr, "Error: modo inválido '%s' (stats o record)\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'i':
+            report_ms = (unsigned int)atoi(optarg);
+            if (report_ms == 0)
+            {
+                fprintf(stderr, "Error: intervalo inválido '%s'\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        default:
+            fprintf(stderr, "Uso: %s [-m stats|record] [-i intervalo_ms]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    setup_signal_handlers();
+    if (attach_shared_memory() != 0)
+    {
+        cleanup_resources();
+        return EXIT_FAILURE;
+    }
+    resync_from_snapshot();
+
+    bool game_over = false;
+    uint64_t last_report = monotonic_ms();
+    unsigned long events_at_report = 0;
+    while (!game_over && !stop_requested)
+    {
+        uint64_t now = monotonic_ms();
+        if (mode == OBSERVER_STATS && now - last_report >= report_ms)
+        {
+            printf("events %lu (+%lu, %.0f/s) resyncs %lu\n", events_seen, events_seen - events_at_report,
+                   (events_seen - events_at_report) * 1000.0 / (now - last_report), resyncs);
+            fflush(stdout);
+            last_report = now;
+            events_at_report = events_seen;
+        }
+
+        game_event_t event;
+        event_ring_status_t status = event_ring_read(&game_ext->events, cursor, &event);
+        if (status == EVENT_RING_LAGGED)
+        {
+            resync_from_snapshot();
+            continue;
+        }
+        if (status == EVENT_RING_OK)
+        {
+            cursor++;
+            events_seen++;
+            apply_event(&event);
+            if (mode == OBSERVER_RECORD)
+                record_event(&event);
+            game_over = event.kind == EVENT_GAME_OVER;
+            continue;
+        }
+
+        // Sin eventos nuevos. Si el master terminó sin publicar el fin, no hay nada más que esperar.
+        if (__atomic_load_n(&game_state->game_over, __ATOMIC_ACQUIRE) &&
+            event_ring_read(&game_ext->events, cursor, &event) == EVENT_RING_EMPTY)
+        {
+            game_over = true;
+            break;
+        }
+        usleep(POLL_INTERVAL_US);
+    }
+
+    fflush(stdout);
+    print_summary(game_over);
+    cleanup_resources();
+    return EXIT_SUCCESS;
+}
@@ -10,6 +10,7 @@
 // Variables globales
 game_state_t *game_state = NULL;
 game_sync_t *game_sync = NULL;
+game_ext_t *game_ext = NULL;
 int shm_state_fd = -1;
 int shm_sync_fd = -1;
 bool cleanup_done = false;
@@ -27,7 +28,7 @@ void cleanup_resources()
     // Desconectar memorias compartidas
     if (game_state != NULL)
     {
-        unmap_shared_memory(game_state, sizeof(game_state_t) + game_state->board_width * game_state->board_height * sizeof(int));
+        unmap_shared_memory(game_state, calculate_game_state_size(game_state->board_width, game_state->board_height));
         game_state = NULL;
     }
 
@@ -37,6 +38,13 @@ void cleanup_resources()
         game_sync = NULL;
     }
 
+    if (game_ext != NULL)
+    {
+        sync_release_robust_lock();
+        close_game_ext(game_ext);
+        game_ext = NULL;
+    }
+
     // Cerrar FD's
     if (shm_state_fd != -1)
     {
@@ -110,6 +118,13 @@ int main(int argc, char *argv[])
         cleanup_resources();
         return EXIT_FAILURE;
     }
+
+    // Extensiones opcionales: sin /game_ext se usa el protocolo de semáforos
+    game_ext = open_game_ext();
+    if (game_ext != NULL && game_ext->lock_mode == LOCK_MODE_ROBUST)
+    {
+        sync_use_robust_lock(&game_ext->robust_lock);
+    }
     
     // Abrir la memoria compartida del estado del juego
     shm_state_fd = open_shared_memory(GAME_STATE_NAME, 0, O_RDONLY);
@@ -0,0 +1,57 @@
+#include "player_sdk.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Jugador de ejemplo construido sobre player_sdk: en cada turno va a la celda vecina libre de mayor
+ * recompensa (desempata al azar). Si no hay vecinas libres envía un movimiento cualquiera.
+ */
+
+static unsigned char choose_move(const player_sdk_t *sdk)
+{
+    int x, y;
+    sdk_position(sdk, &x, &y);
+    unsigned char free_mask = sdk_free_neighbors(sdk, x, y);
+    if (free_mask == 0)
+        return (unsigned char)(random() % 8);
+
+    int best_dir = -1, best_value = 0, ties = 0;
+    for (int d = 0; d < 8; ++d)
+    {
+        if (!(free_mask & (1u << d)))
+            continue;
+        int value = sdk_cell(sdk, x + SDK_DIR_OFFSETS[d][0], y + SDK_DIR_OFFSETS[d][1]);
+        if (value > best_value)
+        {
+            best_dir = d;
+            best_value = value;
+            ties = 1;
+        }
+        else if (value == best_value && random() % ++ties == 0)
+        {
+            best_dir = d;
+        }
+    }
+    return (unsigned char)best_dir;
+}
+
+int main(int argc, char *argv[])
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    srandom((unsigned int)(ts.tv_sec ^ ts.tv_nsec));
+
+    player_sdk_t sdk;
+    if (sdk_open(&sdk) != 0)
+        return EXIT_FAILURE;
+
+    while (sdk_wait_turn(&sdk))
+    {
+        if (sdk_send_move(&sdk, choose_move(&sdk)) != 0)
+            break;
+    }
+
+    sdk_close(&sdk);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,327 @@
+#include "shared_memory.h"
+#include "sync_utils.h"
+#include "board_access.h"
+#include "bench_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <time.h>
+
+/*
+ * Jugador generador de carga para encontrar el punto de saturación del master y ejercitar
+ * el planificador de entrada (input_sched.c) y el manejo de EOF. Se usa como cualquier jugador (./master -p ./loadgen ...) y el
+ * perfil se elige por variables de entorno, ya que el master sólo le pasa ancho y alto:
+ *
+ *   LOADGEN_PROFILE      perfil de todos los jugadores loadgen
+ *   LOADGEN_PROFILE_<i>  perfil del jugador i (tiene prioridad)
+ *
+ * Un perfil es una lista separada por comas de:
+ *   flood          envía movimientos válidos sin esperar su turno (sólo lo frena el pipe lleno)
+ *   invalid=R      fracción R (0..1) de movimientos inválidos
+ *   slow=MS        demora MS milisegundos cada respuesta
+ *   burst=N:MS     envía N movimientos y luego se detiene MS milisegundos
+ *   die=N          muere (SIGKILL) luego de N movimientos
+ *   die_locked=N   idem, pero dentro de reader_enter/reader_exit
+ *
+ * Al terminar informa por stderr (stdout es el pipe al master) la latencia de turno observada: el tiempo
+ * entre escribir un movimiento y recibir el siguiente permiso del master.
+ */
+
+#define MAX_LATENCY_SAMPLES 1000000
+#define FLOOD_CHECK_INTERVAL 64 // En modo flood, cada cuántos movimientos se consulta game_over
+
+typedef struct
+{
+    bool flood;
+    double invalid_ratio;
+    unsigned int slow_ms;
+    unsigned int burst_moves;
+    unsigned int burst_pause_ms;
+    unsigned long die_after;
+    bool die_locked;
+} loadgen_profile_t;
+
+static const int DIR_OFFSETS[8][2] = {
+    {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}
+};
+
+// Variables globales
+game_state_t *game_state = NULL;
+game_sync_t *game_sync = NULL;
+game_ext_t *game_ext = NULL;
+size_t game_state_size = 0;
+int player_id = -1;
+int pipe_write_fd = 1; // el master asocia el extremo de escritura del pipe al stdout del jugador
+bench_stats_t latencies;
+unsigned long moves_sent = 0;
+unsigned long invalid_sent = 0;
+uint64_t start_ns = 0;
+volatile sig_atomic_t stop_requested = 0;
+
+static int parse_profile(const char *spec, loadgen_profile_t *profile)
+{
+    memset(profile, 0, sizeof(*profile));
+    if (spec == NULL || *spec == '\0')
+        return 0;
+
+    char buf[256];
+    if (strlen(spec) >= sizeof(buf))
+        return -1;
+    strcpy(buf, spec);
+
+    char *saveptr = NULL;
+    for (char *tok = strtok_r(buf, ",", &saveptr); tok != NULL; tok = strtok_r(NULL, ",", &saveptr))
+    {
+        char *value = strchr(tok, '=');
+        if (value != NULL)
+            *value++ = '\0';
+
+        if (strcmp(tok, "flood") == 0)
+            profile->flood = true;
+        else if (strcmp(tok, "invalid") == 0 && value != NULL)
+            profile->invalid_ratio = atof(value);
+        else if (strcmp(tok, "slow") == 0 && value != NULL)
+            profile->slow_ms = (unsigned int)atoi(value);
+        else if (strcmp(tok, "burst") == 0 && value != NULL &&
+                 sscanf(value, "%u:%u", &profile->burst_moves, &profile->burst_pause_ms) == 2)
+            ;
+        else if (strcmp(tok, "die") == 0 && value != NULL)
+            profile->die_after = strtoul(value, NULL, 10);
+        else if (strcmp(tok, "die_locked") == 0 && value != NULL)
+        {
+            profile->die_after = strtoul(value, NULL, 10);
+            profile->die_locked = true;
+        }
+        else
+            return -1;
+    }
+    return 0;
+}
+
+// Duerme ms milisegundos; una señal de terminación corta la espera
+static void sleep_ms(unsigned int ms)
+{
+    struct timespec ts = {ms / 1000, (ms % 1000) * 1000000L};
+    while (nanosleep(&ts, &ts) == -1 && errno == EINTR && !stop_requested)
+        ;
+}
+
+static void report_stats(void)
+{
+    double elapsed = (bench_now_ns() - start_ns) / 1e9;
+    fprintf(stderr, "loadgen %d: %lu moves (%lu invalid) in %.2fs = %.0f moves/s",
+            player_id, moves_sent, invalid_sent, elapsed, elapsed > 0 ? moves_sent / elapsed : 0.0);
+    if (latencies.count > 0)
+    {
+        fprintf(stderr, "; turn latency us p50 %.1f p90 %.1f p99 %.1f max %.1f",
+                bench_stats_percentile(&latencies, 50) / 1e3, bench_stats_percentile(&latencies, 90) / 1e3,
+                bench_stats_percentile(&latencies, 99) / 1e3, bench_stats_percentile(&latencies, 100) / 1e3);
+    }
+    fprintf(stderr, "\n");
+}
+
+static void cleanup_resources(void)
+{
+    if (game_state != NULL)
+    {
+        unmap_shared_memory(game_state, game_state_size);
+        game_state = NULL;
+    }
+    if (game_sync != NULL)
+    {
+        unmap_shared_memory(game_sync, sizeof(game_sync_t));
+        game_sync = NULL;
+    }
+    if (game_ext != NULL)
+    {
+        sync_release_robust_lock();
+        close_game_ext(game_ext);
+        game_ext = NULL;
+    }
+    bench_stats_free(&latencies);
+}
+
+// Sólo marca el pedido: el informe y la limpieza se hacen en main, fuera del contexto de la señal
+static void signal_handler(int sig)
+{
+    (void)sig;
+    stop_requested = 1;
+}
+
+static void setup_signal_handlers(void)
+{
+    struct sigaction sa;
+    sa.sa_handler = signal_handler;
+    sigemptyset(&sa.sa_mask);
+    // Con SA_RESTART los sem_wait del lock se reanudan en lugar de volver sin el lock tomado. La espera del
+    // turno termina igual: al finalizar, el master habilita a todos los jugadores
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    // Si el master cierra el pipe, write devuelve EPIPE en lugar de matar al proceso
+    signal(SIGPIPE, SIG_IGN);
+}
+
+static int attach_shared_memory(void)
+{
+    int fd = open_shared_memory(GAME_SYNC_NAME, sizeof(game_sync_t), O_RDWR);
+    if (fd == -1)
+    {
+        fprintf(stderr, "loadgen must be started by master process\n");
+        return -1;
+    }
+    game_sync = map_shared_memory(fd, sizeof(game_sync_t), false);
+    close_shared_memory(fd);
+    if (game_sync == NULL)
+        return -1;
+
+    game_ext = open_game_ext();
+    if (game_ext != NULL && game_ext->lock_mode == LOCK_MODE_ROBUST)
+        sync_use_robust_lock(&game_ext->robust_lock);
+
+    fd = open_shared_memory(GAME_STATE_NAME, 0, O_RDONLY);
+    if (fd == -1)
+        return -1;
+    struct stat st;
+    if (fstat(fd, &st) == -1)
+    {
+        perror("fstat");
+        close_shared_memory(fd);
+        return -1;
+    }
+    game_state_size = st.st_size;
+    game_state = map_shared_memory(fd, game_state_size, true);
+    close_shared_memory(fd);
+    return game_state == NULL ? -1 : 0;
+}
+
+static int find_my_player_id(void)
+{
+    pid_t my_pid = getpid();
+    for (unsigned int i = 0; i < game_state->player_count; i++)
+    {
+        if (game_state->players[i].pid == my_pid)
+            return (int)i;
+    }
+    return -1;
+}
+
+// Elige una dirección hacia una celda libre (valid=true) u ocupada/fuera del tablero (valid=false)
+static unsigned char choose_direction(bool valid)
+{
+    unsigned char candidates[8];
+    int count = 0;
+
+    reader_enter(game_sync);
+    const player_hot_t *me = PLAYER_HOT(game_state, player_id);
+    for (int d = 0; d < 8; ++d)
+    {
+        int nx = me->pos_x + DIR_OFFSETS[d][0];
+        int ny = me->pos_y + DIR_OFFSETS[d][1];
+        bool free_cell = board_in_bounds(game_state, nx, ny) && BOARD_CELL(game_state, nx, ny) > 0;
+        if (free_cell == valid)
+            candidates[count++] = (unsigned char)d;
+    }
+    reader_exit(game_sync);
+
+    if (count == 0)
+        return valid ? (unsigned char)(random() % 8) : 8; // 8: dirección fuera de rango
+    return candidates[random() % count];
+}
+
+static bool game_is_over(const loadgen_profile_t *profile)
+{
+    reader_enter(game_sync);
+    if (profile->die_after > 0 && profile->die_locked && moves_sent >= profile->die_after)
+        raise(SIGKILL); // Muere con el lock de lectura tomado
+    bool over = game_state->game_over;
+    reader_exit(game_sync);
+    return over;
+}
+
+int main(int argc, char *argv[])
+{
+    start_ns = bench_now_ns();
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    srandom((unsigned int)(ts.tv_sec ^ ts.tv_nsec ^ getpid()));
+
+    setup_signal_handlers();
+    if (bench_stats_init(&latencies, MAX_LATENCY_SAMPLES) != 0 || attach_shared_memory() != 0)
+    {
+        cleanup_resources();
+        return EXIT_FAILURE;
+    }
+
+    // El master completa el pid luego del fork: reintentar por si todavía no lo escribió
+    for (int attempt = 0; attempt < 100 && player_id == -1; ++attempt)
+    {
+        if (attempt > 0)
+            sleep_ms(10);
+        reader_enter(game_sync);
+        player_id = find_my_player_id();
+        reader_exit(game_sync);
+    }
+    if (player_id == -1)
+    {
+        fprintf(stderr, "Error: no se pudo identificar al jugador\n");
+        cleanup_resources();
+        return EXIT_FAILURE;
+    }
+
+    char env_name[32];
+    snprintf(env_name, sizeof(env_name), "LOADGEN_PROFILE_%d", player_id);
+    const char *spec = getenv(env_name);
+    if (spec == NULL)
+        spec = getenv("LOADGEN_PROFILE");
+    loadgen_profile_t profile;
+    if (parse_profile(spec, &profile) != 0)
+    {
+        fprintf(stderr, "Error: perfil de loadgen inválido: '%s'\n", spec);
+        cleanup_resources();
+        return EXIT_FAILURE;
+    }
+
+    uint64_t last_write_ns = 0;
+    while (!stop_requested)
+    {
+        if (!profile.flood)
+        {
+            wait_player_turn(game_sync, player_id);
+            if (stop_requested)
+                break;
+            if (last_write_ns != 0)
+                bench_stats_add(&latencies, (double)(bench_now_ns() - last_write_ns));
+        }
+
+        if ((!profile.flood || moves_sent % FLOOD_CHECK_INTERVAL == 0) && game_is_over(&profile))
+            break;
+
+        if (profile.die_after > 0 && !profile.die_locked && moves_sent >= profile.die_after)
+            raise(SIGKILL);
+
+        bool send_invalid = profile.invalid_ratio > 0 && (double)random() / RAND_MAX < profile.invalid_ratio;
+        unsigned char move = choose_direction(!send_invalid);
+
+        if (profile.slow_ms > 0)
+            sleep_ms(profile.slow_ms);
+        if (stop_requested)
+            break;
+
+        if (write(pipe_write_fd, &move, sizeof(move)) != sizeof(move))
+            break; // El master cerró el pipe
+        last_write_ns = bench_now_ns();
+        moves_sent++;
+        invalid_sent += send_invalid;
+
+        if (profile.burst_moves > 0 && moves_sent % profile.burst_moves == 0)
+            sleep_ms(profile.burst_pause_ms);
+    }
+
+    report_stats();
+    cleanup_resources();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,633 @@
+#include "player_sdk.h"
+#include "bench_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+
+/*
+ * Jugador Monte Carlo Tree Search multihilo. En cada turno toma una foto del tablero (la copia local de
+ * player_sdk), la pasa a formato bitboard (un bit por celda libre) y lanza la búsqueda en un pool de
+ * hilos fijo que comparte un único árbol:
+ *
+ * - El árbol tiene sólo los movimientos propios ("open loop"): en cada paso del descenso los rivales hacen
+ *   un movimiento aleatorio, igual que en las simulaciones.
+ * - La expansión es sin locks: cada hijo se publica con un compare-and-swap sobre su índice, y los nodos
+ *   salen de un pool preasignado con un contador atómico.
+ * - Virtual loss: mientras un hilo recorre un nodo, éste cuenta como una visita perdida para los demás,
+ *   así los hilos se reparten entre ramas distintas en lugar de recorrer todos la misma.
+ * - Cada simulación juega PLAYOUT_ROUNDS rondas con movimientos aleatorios sobre el bitboard; el valor es
+ *   la diferencia entre la recompensa capturada por el jugador y la del mejor rival.
+ * - La búsqueda termina por plazo (MCTS_BUDGET_MS) y se elige el hijo de la raíz más visitado.
+ *
+ * Configuración por variables de entorno (el master sólo pasa ancho y alto):
+ *   MCTS_THREADS    hilos de búsqueda (por defecto, las CPUs de su afinidad)
+ *   MCTS_BUDGET_MS  tiempo de búsqueda por movimiento (por defecto DEFAULT_BUDGET_MS)
+ *
+ * Al terminar informa por stderr las simulaciones por segundo. Para medir la escalabilidad del motor sin
+ * master: ./mcts -b [-w ancho] [-h alto] [-m ms] [-T hilos_max]
+ */
+
+#define DEFAULT_BUDGET_MS 50
+#define MAX_THREADS 64
+#define MAX_NODES (1 << 18)
+#define PLAYOUT_ROUNDS 48
+#define UCT_C 1.2
+#define VALUE_SCALE 1000000ull // Valores en punto fijo
+#define CLOCK_CHECK_INTERVAL 16
+#define UNEXPANDED -1
+#define MAX_SIM_MOVES (2 * PLAYOUT_ROUNDS * MAX_PLAYERS) // Descenso más simulación, todos los jugadores
+
+typedef struct
+{
+    int32_t children[8]; // Índice del hijo en el pool o UNEXPANDED
+    uint32_t visits;
+    uint32_t virtual_loss;
+    uint64_t value; // Suma de los valores de las simulaciones, en punto fijo
+} mcts_node_t;
+
+// Foto del juego sobre la que se busca
+typedef struct
+{
+    int width, height;
+    int words; // Palabras de 64 bits del bitboard
+    unsigned int player_count;
+    int me;
+    uint64_t *free_bits;
+    int8_t *reward; // Recompensa de cada celda (0 si está ocupada)
+    int pos_x[MAX_PLAYERS], pos_y[MAX_PLAYERS];
+    bool blocked[MAX_PLAYERS];
+} mcts_snapshot_t;
+
+// Estado de una simulación, privado de cada hilo. free_bits se copia de la foto una vez por búsqueda; cada
+// simulación anota en undo las celdas que ocupa y al terminar las libera de nuevo.
+typedef struct
+{
+    uint64_t *free_bits;
+    int32_t undo[MAX_SIM_MOVES];
+    int undo_count;
+    int pos_x[MAX_PLAYERS], pos_y[MAX_PLAYERS];
+    bool blocked[MAX_PLAYERS];
+    unsigned long gain[MAX_PLAYERS];
+    uint64_t rng;
+} mcts_sim_t;
+
+typedef struct
+{
+    const mcts_snapshot_t *snap;
+    mcts_node_t *nodes;
+    uint32_t node_count;
+    uint64_t deadline_ns;
+    bool quit;
+    int threads;
+    pthread_t tids[MAX_THREADS];
+    pthread_mutex_t mutex;
+    pthread_cond_t start_cond, done_cond;
+    unsigned long generation; // Se incrementa en cada búsqueda
+    int done;                 // Hilos que terminaron la búsqueda actual
+    unsigned long long playouts[MAX_THREADS];
+} mcts_pool_t;
+
+typedef struct
+{
+    mcts_pool_t *pool;
+    int id;
+} worker_arg_t;
+
+static const int DIRS[8][2] = {
+    {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}
+};
+
+static inline uint64_t xorshift(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+static inline bool cell_free(const uint64_t *bits, int cell)
+{
+    return (bits[cell >> 6] >> (cell & 63)) & 1;
+}
+
+static inline unsigned int free_neighbors(const mcts_snapshot_t *snap, const uint64_t *bits, int x, int y)
+{
+    unsigned int mask = 0;
+    for (int d = 0; d < 8; ++d)
+    {
+        int nx = x + DIRS[d][0], ny = y + DIRS[d][1];
+        if (nx >= 0 && nx < snap->width && ny >= 0 && ny < snap->height && cell_free(bits, ny * snap->width + nx))
+            mask |= 1u << d;
+    }
+    return mask;
+}
+
+// Dirección al azar entre los bits de mask (mask != 0)
+static inline int random_dir(unsigned int mask, uint64_t *rng)
+{
+    int n = __builtin_popcount(mask);
+    int k = (int)(xorshift(rng) % (uint64_t)n);
+    while (k-- > 0)
+        mask &= mask - 1;
+    return __builtin_ctz(mask);
+}
+
+static inline void apply_move(const mcts_snapshot_t *snap, mcts_sim_t *sim, int p, int d)
+{
+    int x = sim->pos_x[p] + DIRS[d][0], y = sim->pos_y[p] + DIRS[d][1];
+    int cell = y * snap->width + x;
+    sim->free_bits[cell >> 6] &= ~(1ull << (cell & 63));
+    sim->undo[sim->undo_count++] = cell;
+    sim->gain[p] += (unsigned long)snap->reward[cell];
+    sim->pos_x[p] = x;
+    sim->pos_y[p] = y;
+}
+
+// Un movimiento aleatorio de cada jugador activo distinto de skip (-1: todos)
+static void random_round(const mcts_snapshot_t *snap, mcts_sim_t *sim, int skip)
+{
+    for (unsigned int p = 0; p < snap->player_count; ++p)
+    {
+        if ((int)p == skip || sim->blocked[p])
+            continue;
+        unsigned int mask = free_neighbors(snap, sim->free_bits, sim->pos_x[p], sim->pos_y[p]);
+        if (mask == 0)
+        {
+            sim->blocked[p] = true;
+            continue;
+        }
+        apply_move(snap, sim, (int)p, random_dir(mask, &sim->rng));
+    }
+}
+
+static uint64_t playout(const mcts_snapshot_t *snap, mcts_sim_t *sim)
+{
+    for (int round = 0; round < PLAYOUT_ROUNDS; ++round)
+        random_round(snap, sim, -1);
+
+    // Diferencia contra el mejor rival llevada a [0, 1]: a lo sumo 2 * PLAYOUT_ROUNDS movimientos (descenso
+    // más simulación) de recompensa 9. Sin rivales sigue premiando capturar más y sobrevivir más tiempo.
+    long mine = (long)sim->gain[snap->me], best_other = 0;
+    for (unsigned int p = 0; p < snap->player_count; ++p)
+        if ((int)p != snap->me && (long)sim->gain[p] > best_other)
+            best_other = (long)sim->gain[p];
+    const long span = 2 * 2 * PLAYOUT_ROUNDS * 9;
+    return (uint64_t)((mine - best_other + span / 2) * (long)VALUE_SCALE / span);
+}
+
+static double uct_score(const mcts_node_t *child, double log_parent)
+{
+    uint32_t vl = __atomic_load_n(&child->virtual_loss, __ATOMIC_RELAXED);
+    uint32_t n = __atomic_load_n(&child->visits, __ATOMIC_RELAXED) + vl;
+    if (n == 0)
+        return INFINITY;
+    double mean = (double)__atomic_load_n(&child->value, __ATOMIC_RELAXED) / VALUE_SCALE / n; // virtual loss: valor 0
+    return mean + UCT_C * sqrt(log_parent / n);
+}
+
+// Hijo d de node, creándolo si hace falta. Retorna -1 si se agotó el pool.
+static int32_t get_or_expand(mcts_pool_t *pool, mcts_node_t *node, int d, bool *created)
+{
+    int32_t idx = __atomic_load_n(&node->children[d], __ATOMIC_ACQUIRE);
+    *created = false;
+    if (idx != UNEXPANDED)
+        return idx;
+
+    uint32_t fresh = __atomic_fetch_add(&pool->node_count, 1, __ATOMIC_RELAXED);
+    if (fresh >= MAX_NODES)
+        return -1;
+    mcts_node_t *n = &pool->nodes[fresh];
+    memset(n, 0, sizeof(*n));
+    for (int i = 0; i < 8; ++i)
+        n->children[i] = UNEXPANDED;
+
+    int32_t expected = UNEXPANDED;
+    if (__atomic_compare_exchange_n(&node->children[d], &expected, (int32_t)fresh, false, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+    {
+        *created = true;
+        return (int32_t)fresh;
+    }
+    return expected; // Otro hilo lo expandió primero; el nodo reservado queda sin usar
+}
+
+static void search_iteration(mcts_pool_t *pool, mcts_sim_t *sim)
+{
+    const mcts_snapshot_t *snap = pool->snap;
+    sim->undo_count = 0;
+    memcpy(sim->pos_x, snap->pos_x, sizeof(sim->pos_x));
+    memcpy(sim->pos_y, snap->pos_y, sizeof(sim->pos_y));
+    memcpy(sim->blocked, snap->blocked, sizeof(sim->blocked));
+    memset(sim->gain, 0, sizeof(sim->gain));
+
+    int32_t path[PLAYOUT_ROUNDS + 1];
+    int depth = 0;
+    mcts_node_t *node = &pool->nodes[0];
+    path[depth++] = 0;
+
+    while (depth <= PLAYOUT_ROUNDS)
+    {
+        unsigned int mask = free_neighbors(snap, sim->free_bits, sim->pos_x[snap->me], sim->pos_y[snap->me]);
+        if (mask == 0)
+        {
+            sim->blocked[snap->me] = true;
+            break;
+        }
+
+        // Primero los hijos sin expandir (en orden aleatorio), después UCT
+        int chosen = -1;
+        unsigned int unexpanded = 0;
+        for (int d = 0; d < 8; ++d)
+            if ((mask & (1u << d)) && __atomic_load_n(&node->children[d], __ATOMIC_ACQUIRE) == UNEXPANDED)
+                unexpanded |= 1u << d;
+        if (unexpanded != 0)
+        {
+            chosen = random_dir(unexpanded, &sim->rng);
+        }
+        else
+        {
+            double log_parent = log((double)__atomic_load_n(&node->visits, __ATOMIC_RELAXED) + 1.0);
+            double best = -1.0;
+            for (int d = 0; d < 8; ++d)
+            {
+                if (!(mask & (1u << d)))
+                    continue;
+                double score = uct_score(&pool->nodes[node->children[d]], log_parent);
+                if (score > best)
+                {
+                    best = score;
+                    chosen = d;
+                }
+            }
+        }
+
+        bool created;
+        int32_t child = get_or_expand(pool, node, chosen, &created);
+        apply_move(snap, sim, snap->me, chosen);
+        random_round(snap, sim, snap->me);
+        if (child < 0)
+            break; // Pool agotado: se sigue con la simulación desde acá
+
+        node = &pool->nodes[child];
+        __atomic_fetch_add(&node->virtual_loss, 1, __ATOMIC_RELAXED);
+        path[depth++] = child;
+        if (created)
+            break;
+    }
+
+    uint64_t value = playout(snap, sim);
+    for (int i = 0; i < depth; ++i)
+    {
+        mcts_node_t *n = &pool->nodes[path[i]];
+        __atomic_fetch_add(&n->visits, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&n->value, value, __ATOMIC_RELAXED);
+        if (i > 0)
+            __atomic_fetch_sub(&n->virtual_loss, 1, __ATOMIC_RELAXED);
+    }
+
+    // Sólo se ocupan celdas libres, así que deshacer es volver a marcarlas
+    for (int i = 0; i < sim->undo_count; ++i)
+        sim->free_bits[sim->undo[i] >> 6] |= 1ull << (sim->undo[i] & 63);
+}
+
+static void *worker_main(void *arg)
+{
+    worker_arg_t *w = arg;
+    mcts_pool_t *pool = w->pool;
+    mcts_sim_t sim;
+    sim.free_bits = NULL;
+    sim.rng = 0x9E3779B97F4A7C15ull * (uint64_t)(w->id + 1) ^ bench_now_ns();
+    int words = 0;
+    unsigned long seen = 0;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&pool->mutex);
+        while (pool->generation == seen && !pool->quit)
+            pthread_cond_wait(&pool->start_cond, &pool->mutex);
+        seen = pool->generation;
+        bool quit = pool->quit;
+        pthread_mutex_unlock(&pool->mutex);
+        if (quit)
+            break;
+        if (pool->snap->words > words)
+        {
+            free(sim.free_bits);
+            words = pool->snap->words;
+            sim.free_bits = malloc((size_t)words * sizeof(uint64_t));
+        }
+        if (sim.free_bits != NULL)
+            memcpy(sim.free_bits, pool->snap->free_bits, (size_t)pool->snap->words * sizeof(uint64_t));
+
+        unsigned long long count = 0;
+        if (sim.free_bits != NULL)
+        {
+            do
+            {
+                for (int i = 0; i < CLOCK_CHECK_INTERVAL; ++i)
+                    search_iteration(pool, &sim);
+                count += CLOCK_CHECK_INTERVAL;
+            } while (bench_now_ns() < pool->deadline_ns);
+        }
+        pool->playouts[w->id] += count;
+
+        pthread_mutex_lock(&pool->mutex);
+        if (++pool->done == pool->threads)
+            pthread_cond_signal(&pool->done_cond);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+    free(sim.free_bits);
+    return NULL;
+}
+
+static int pool_start(mcts_pool_t *pool, int threads, worker_arg_t args[])
+{
+    memset(pool, 0, sizeof(*pool));
+    pool->threads = threads;
+    pool->nodes = malloc(MAX_NODES * sizeof(mcts_node_t));
+    if (pool->nodes == NULL)
+    {
+        perror("malloc (árbol)");
+        return -1;
+    }
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->start_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+    for (int i = 0; i < threads; ++i)
+    {
+        args[i].pool = pool;
+        args[i].id = i;
+        if (pthread_create(&pool->tids[i], NULL, worker_main, &args[i]) != 0)
+        {
+            perror("pthread_create");
+            pool->threads = i; // Seguir con los hilos que se pudieron crear
+            break;
+        }
+    }
+    if (pool->threads == 0)
+    {
+        free(pool->nodes);
+        return -1;
+    }
+    if (pool->threads < threads)
+        fprintf(stderr, "Advertencia: sólo se crearon %d hilos de búsqueda\n", pool->threads);
+    return 0;
+}
+
+static void pool_stop(mcts_pool_t *pool)
+{
+    pthread_mutex_lock(&pool->mutex);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->start_cond);
+    pthread_mutex_unlock(&pool->mutex);
+    for (int i = 0; i < pool->threads; ++i)
+        pthread_join(pool->tids[i], NULL);
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->start_cond);
+    pthread_cond_destroy(&pool->done_cond);
+    free(pool->nodes);
+}
+
+// Busca durante budget_ms y retorna la mejor dirección, o -1 si el jugador no tiene movimientos
+static int pool_search(mcts_pool_t *pool, const mcts_snapshot_t *snap, unsigned int budget_ms)
+{
+    if (free_neighbors(snap, snap->free_bits, snap->pos_x[snap->me], snap->pos_y[snap->me]) == 0)
+        return -1;
+
+    pool->snap = snap;
+    mcts_node_t *root = &pool->nodes[0];
+    memset(root, 0, sizeof(*root));
+    for (int d = 0; d < 8; ++d)
+        root->children[d] = UNEXPANDED;
+    pool->node_count = 1;
+    pool->deadline_ns = bench_now_ns() + (uint64_t)budget_ms * 1000000ull;
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->done = 0;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start_cond);
+    while (pool->done < pool->threads)
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    pthread_mutex_unlock(&pool->mutex);
+
+    int best = -1;
+    uint32_t best_visits = 0;
+    for (int d = 0; d < 8; ++d)
+    {
+        int32_t child = root->children[d];
+        if (child != UNEXPANDED && (best == -1 || pool->nodes[child].visits > best_visits))
+        {
+            best = d;
+            best_visits = pool->nodes[child].visits;
+        }
+    }
+    return best;
+}
+
+static unsigned long long total_playouts(const mcts_pool_t *pool)
+{
+    unsigned long long total = 0;
+    for (int i = 0; i < pool->threads; ++i)
+        total += pool->playouts[i];
+    return total;
+}
+
+static int snapshot_alloc(mcts_snapshot_t *snap, int width, int height)
+{
+    memset(snap, 0, sizeof(*snap));
+    snap->width = width;
+    snap->height = height;
+    snap->words = (width * height + 63) / 64;
+    snap->free_bits = calloc((size_t)snap->words, sizeof(uint64_t));
+    snap->reward = calloc((size_t)width * height, sizeof(int8_t));
+    if (snap->free_bits == NULL || snap->reward == NULL)
+    {
+        perror("calloc (foto del tablero)");
+        return -1;
+    }
+    return 0;
+}
+
+static void snapshot_free(mcts_snapshot_t *snap)
+{
+    free(snap->free_bits);
+    free(snap->reward);
+}
+
+static void snapshot_from_board(mcts_snapshot_t *snap, const int *board)
+{
+    memset(snap->free_bits, 0, (size_t)snap->words * sizeof(uint64_t));
+    for (int cell = 0; cell < snap->width * snap->height; ++cell)
+    {
+        if (board[cell] > 0)
+        {
+            snap->free_bits[cell >> 6] |= 1ull << (cell & 63);
+            snap->reward[cell] = (int8_t)board[cell];
+        }
+        else
+        {
+            snap->reward[cell] = 0;
+        }
+    }
+}
+
+static void snapshot_from_sdk(mcts_snapshot_t *snap, const player_sdk_t *sdk)
+{
+    snapshot_from_board(snap, sdk->board);
+    snap->player_count = sdk->player_count;
+    snap->me = sdk->player_id;
+    for (unsigned int p = 0; p < sdk->player_count; ++p)
+    {
+        snap->pos_x[p] = sdk->players[p].pos_x;
+        snap->pos_y[p] = sdk->players[p].pos_y;
+        snap->blocked[p] = sdk->players[p].is_blocked;
+    }
+}
+
+static unsigned int env_uint(const char *name, unsigned int def, unsigned int max)
+{
+    const char *value = getenv(name);
+    if (value == NULL)
+        return def;
+    long v = atol(value);
+    return (v >= 1 && v <= (long)max) ? (unsigned int)v : def;
+}
+
+// Una por CPU permitida: con master -A el jugador queda fijado a un subconjunto de CPUs
+static int default_threads(void)
+{
+    cpu_set_t allowed;
+    long cpus = sched_getaffinity(0, sizeof(allowed), &allowed) == 0 ? CPU_COUNT(&allowed) : sysconf(_SC_NPROCESSORS_ONLN);
+    return (int)(cpus < 1 ? 1 : (cpus > MAX_THREADS ? MAX_THREADS : cpus));
+}
+
+// Escalabilidad del motor sobre un tablero sintético, con 1, 2, 4, ... hasta max_threads hilos
+static int run_bench(int width, int height, unsigned int budget_ms, int max_threads)
+{
+    mcts_snapshot_t snap;
+    if (snapshot_alloc(&snap, width, height) != 0)
+        return EXIT_FAILURE;
+    int *board = malloc((size_t)width * height * sizeof(int));
+    if (board == NULL)
+    {
+        perror("malloc (tablero)");
+        return EXIT_FAILURE;
+    }
+    srand(1234);
+    for (int i = 0; i < width * height; ++i)
+        board[i] = rand() % 9 + 1;
+    snap.player_count = 4;
+    snap.me = 0;
+    int corners[4][2] = {{width / 4, height / 4}, {3 * width / 4, height / 4}, {width / 4, 3 * height / 4}, {3 * width / 4, 3 * height / 4}};
+    for (int p = 0; p < 4; ++p)
+    {
+        snap.pos_x[p] = corners[p][0];
+        snap.pos_y[p] = corners[p][1];
+        board[corners[p][1] * width + corners[p][0]] = 0;
+    }
+    snapshot_from_board(&snap, board);
+
+    printf("%-8s %14s %10s %10s\n", "threads", "playouts/s", "speedup", "nodes");
+    double base = 0;
+    for (int threads = 1; threads <= max_threads; threads = threads * 2 > max_threads && threads < max_threads ? max_threads : threads * 2)
+    {
+        mcts_pool_t pool;
+        worker_arg_t args[MAX_THREADS];
+        if (pool_start(&pool, threads, args) != 0)
+            break;
+        uint64_t start = bench_now_ns();
+        pool_search(&pool, &snap, budget_ms);
+        double seconds = (double)(bench_now_ns() - start) / 1e9;
+        double rate = (double)total_playouts(&pool) / seconds;
+        if (threads == 1)
+            base = rate;
+        printf("%-8d %14.0f %9.2fx %10u\n", pool.threads, rate, base > 0 ? rate / base : 0.0,
+               pool.node_count < MAX_NODES ? pool.node_count : MAX_NODES);
+        pool_stop(&pool);
+    }
+    free(board);
+    snapshot_free(&snap);
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && strcmp(argv[1], "-b") == 0)
+    {
+        int width = 100, height = 100, max_threads = default_threads();
+        unsigned int budget_ms = 1000;
+        int opt;
+        optind = 2;
+        while ((opt = getopt(argc, argv, "w:h:m:T:")) != -1)
+        {
+            switch (opt)
+            {
+            case 'w':
+                width = atoi(optarg);
+                break;
+            case 'h':
+                height = atoi(optarg);
+                break;
+            case 'm':
+                budget_ms = (unsigned int)atoi(optarg);
+                break;
+            case 'T':
+                max_threads = atoi(optarg);
+                break;
+            default:
+                fprintf(stderr, "Uso: %s -b [-w ancho] [-h alto] [-m ms] [-T hilos_max]\n", argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+        if (width < 4 || height < 4 || budget_ms < 1 || max_threads < 1 || max_threads > MAX_THREADS)
+        {
+            fprintf(stderr, "Error: parámetros de benchmark inválidos\n");
+            return EXIT_FAILURE;
+        }
+        return run_bench(width, height, budget_ms, max_threads);
+    }
+
+    unsigned int budget_ms = env_uint("MCTS_BUDGET_MS", DEFAULT_BUDGET_MS, 60000);
+    int threads = (int)env_uint("MCTS_THREADS", (unsigned int)default_threads(), MAX_THREADS);
+
+    player_sdk_t sdk;
+    if (sdk_open(&sdk) != 0)
+        return EXIT_FAILURE;
+
+    mcts_snapshot_t snap;
+    mcts_pool_t pool;
+    worker_arg_t args[MAX_THREADS];
+    if (snapshot_alloc(&snap, sdk.width, sdk.height) != 0 || pool_start(&pool, threads, args) != 0)
+    {
+        sdk_close(&sdk);
+        return EXIT_FAILURE;
+    }
+
+    uint64_t search_ns = 0;
+    unsigned long moves = 0;
+    while (sdk_wait_turn(&sdk))
+    {
+        snapshot_from_sdk(&snap, &sdk);
+        uint64_t start = bench_now_ns();
+        int dir = pool_search(&pool, &snap, budget_ms);
+        search_ns += bench_now_ns() - start;
+        if (dir < 0)
+            dir = 0; // Sin movimientos: el master lo marcará bloqueado
+        moves++;
+        if (sdk_send_move(&sdk, (unsigned char)dir) != 0)
+            break;
+    }
+
+    unsigned long long playouts = total_playouts(&pool);
+    fprintf(stderr, "mcts %d: %lu moves, %d threads, %llu playouts in %.2fs = %.0f playouts/s\n",
+            sdk.player_id, moves, pool.threads, playouts, search_ns / 1e9,
+            search_ns > 0 ? playouts / (search_ns / 1e9) : 0.0);
+
+    pool_stop(&pool);
+    snapshot_free(&snap);
+    sdk_close(&sdk);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,212 @@
+#include "player_sdk.h"
+#include "board_access.h"
+#include "zobrist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#define IDENTIFY_ATTEMPTS 100
+#define IDENTIFY_RETRY_MS 10
+
+const int SDK_DIR_OFFSETS[8][2] = {
+    {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}
+};
+
+static int find_player_id(const game_state_t *state) {
+    pid_t my_pid = getpid();
+    for (unsigned int i = 0; i < state->player_count; i++) {
+        if (state->players[i].pid == my_pid) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+// Copia completa del tablero compartido; se llama con el lock de lectura tomado
+static void full_resync(player_sdk_t *sdk) {
+    const game_state_t *state = sdk->state;
+    for (unsigned short y = 0; y < sdk->height; ++y) {
+        memcpy(&sdk->board[(size_t)y * sdk->width], &BOARD_CELL(state, 0, y), sdk->width * sizeof(int));
+    }
+
+    sdk->remaining_reward = 0;
+    sdk->free_cells = 0;
+    size_t cells = (size_t)sdk->width * sdk->height;
+    for (size_t i = 0; i < cells; ++i) {
+        if (sdk->board[i] > 0) {
+            sdk->remaining_reward += sdk->board[i];
+            sdk->free_cells++;
+        }
+    }
+
+    sdk->cursor = sdk->ext != NULL ? sdk->ext->change_log.head : 0;
+    sdk->full_resyncs++;
+}
+
+static void apply_change(player_sdk_t *sdk, const change_log_entry_t *entry) {
+    int *cell = &sdk->board[entry->cell];
+    if (*cell > 0 && entry->value <= 0) {
+        sdk->remaining_reward -= *cell;
+        sdk->free_cells--;
+    } else if (*cell <= 0 && entry->value > 0) {
+        sdk->remaining_reward += entry->value;
+        sdk->free_cells++;
+    }
+    *cell = entry->value;
+    sdk->changes_applied++;
+}
+
+int sdk_sync(player_sdk_t *sdk) {
+    reader_enter(sdk->sync);
+
+    sdk->player_count = sdk->state->player_count;
+    for (unsigned int i = 0; i < sdk->player_count && i < MAX_PLAYERS; ++i) {
+        sdk->players[i] = *PLAYER_HOT(sdk->state, i);
+    }
+    sdk->game_over = sdk->state->game_over;
+
+    if (sdk->ext == NULL) {
+        full_resync(sdk);
+        sdk->board_hash = zobrist_hash_state(sdk->state);
+    } else {
+        sdk->board_hash = sdk->ext->board_hash;
+        const change_log_t *log = &sdk->ext->change_log;
+        bool gap = log->head - sdk->cursor > CHANGE_LOG_CAPACITY;
+        for (uint64_t seq = sdk->cursor; !gap && seq < log->head; ++seq) {
+            const change_log_entry_t *entry = change_log_get(log, seq);
+            if (entry == NULL) {
+                gap = true;
+            } else {
+                apply_change(sdk, entry);
+            }
+        }
+        if (gap) {
+            full_resync(sdk);
+        } else {
+            sdk->cursor = log->head;
+        }
+    }
+
+    reader_exit(sdk->sync);
+    return 0;
+}
+
+int sdk_open(player_sdk_t *sdk) {
+    memset(sdk, 0, sizeof(*sdk));
+    sdk->player_id = -1;
+    sdk->pipe_write_fd = STDOUT_FILENO; // el master asocia el extremo de escritura del pipe al stdout del jugador
+
+    int fd = open_shared_memory(GAME_SYNC_NAME, sizeof(game_sync_t), O_RDWR);
+    if (fd == -1) {
+        fprintf(stderr, "Player must be started by master process\n");
+        return -1;
+    }
+    sdk->sync = map_shared_memory(fd, sizeof(game_sync_t), false);
+    close_shared_memory(fd);
+    if (sdk->sync == NULL) {
+        sdk_close(sdk);
+        return -1;
+    }
+
+    sdk->ext = open_game_ext();
+    if (sdk->ext != NULL && sdk->ext->lock_mode == LOCK_MODE_ROBUST) {
+        sync_use_robust_lock(&sdk->ext->robust_lock);
+    }
+
+    fd = open_shared_memory(GAME_STATE_NAME, 0, O_RDONLY);
+    if (fd == -1) {
+        sdk_close(sdk);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        perror("fstat");
+        close_shared_memory(fd);
+        sdk_close(sdk);
+        return -1;
+    }
+    sdk->state_size = st.st_size;
+    sdk->state = map_shared_memory(fd, sdk->state_size, true);
+    close_shared_memory(fd);
+    if (sdk->state == NULL) {
+        sdk_close(sdk);
+        return -1;
+    }
+
+    // El master completa el pid luego del fork: reintentar por si todavía no lo escribió
+    for (int attempt = 0; attempt < IDENTIFY_ATTEMPTS && sdk->player_id == -1; ++attempt) {
+        if (attempt > 0) {
+            struct timespec ts = {0, IDENTIFY_RETRY_MS * 1000000L};
+            nanosleep(&ts, NULL);
+        }
+        reader_enter(sdk->sync);
+        sdk->player_id = find_player_id(sdk->state);
+        reader_exit(sdk->sync);
+    }
+    if (sdk->player_id == -1) {
+        fprintf(stderr, "Error: no se pudo identificar al jugador\n");
+        sdk_close(sdk);
+        return -1;
+    }
+
+    sdk->width = sdk->state->board_width;
+    sdk->height = sdk->state->board_height;
+    sdk->board = malloc((size_t)sdk->width * sdk->height * sizeof(int));
+    if (sdk->board == NULL) {
+        perror("malloc (tablero local)");
+        sdk_close(sdk);
+        return -1;
+    }
+
+    // Primera sincronización: siempre completa
+    reader_enter(sdk->sync);
+    full_resync(sdk);
+    reader_exit(sdk->sync);
+    return sdk_sync(sdk);
+}
+
+void sdk_close(player_sdk_t *sdk) {
+    free(sdk->board);
+    sdk->board = NULL;
+
+    if (sdk->state != NULL) {
+        unmap_shared_memory(sdk->state, sdk->state_size);
+        sdk->state = NULL;
+    }
+    if (sdk->sync != NULL) {
+        unmap_shared_memory(sdk->sync, sizeof(game_sync_t));
+        sdk->sync = NULL;
+    }
+    if (sdk->ext != NULL) {
+        sync_release_robust_lock();
+        close_game_ext(sdk->ext);
+        sdk->ext = NULL;
+    }
+}
+
+bool sdk_wait_turn(player_sdk_t *sdk) {
+    wait_player_turn(sdk->sync, sdk->player_id);
+    sdk_sync(sdk);
+    return !sdk->game_over;
+}
+
+int sdk_send_move(player_sdk_t *sdk, unsigned char direction) {
+    if (write(sdk->pipe_write_fd, &direction, sizeof(direction)) != sizeof(direction)) {
+        return -1;
+    }
+    return 0;
+}
+
+unsigned char sdk_free_neighbors(const player_sdk_t *sdk, int x, int y) {
+    unsigned char mask = 0;
+    for (int d = 0; d < 8; ++d) {
+        int nx = x + SDK_DIR_OFFSETS[d][0];
+        int ny = y + SDK_DIR_OFFSETS[d][1];
+        if (nx >= 0 && nx < sdk->width && ny >= 0 && ny < sdk->height && sdk_cell(sdk, nx, ny) > 0) {
+            mask |= (unsigned char)(1u << d);
+        }
+    }
+    return mask;
+}
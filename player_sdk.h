@@ -0,0 +1,84 @@
+#ifndef PLAYER_SDK_H
+#define PLAYER_SDK_H
+
+#include "shared_memory.h"
+#include "sync_utils.h"
+#include <stdint.h>
+
+/*
+ * Biblioteca para escribir jugadores. Se encarga de conectarse a las memorias compartidas, identificar al
+ * jugador y mantener una copia local del tablero (fila-0, ..., fila-n-1, independiente del formato del
+ * tablero compartido) que se actualiza con el registro de cambios que publica el master en /game_ext. Así
+ * cada turno cuesta O(cambios) en lugar de recorrer todo el tablero. Si se pierden cambios (el jugador
+ * quedó más de CHANGE_LOG_CAPACITY cambios atrás) o el master no publica /game_ext, la copia se rehace
+ * completa.
+ *
+ * Uso típico:
+ *
+ *     player_sdk_t sdk;
+ *     if (sdk_open(&sdk) != 0) return EXIT_FAILURE;
+ *     while (sdk_wait_turn(&sdk))
+ *         sdk_send_move(&sdk, elegir_movimiento(&sdk));
+ *     sdk_close(&sdk);
+ */
+
+extern const int SDK_DIR_OFFSETS[8][2];
+
+typedef struct
+{
+    game_state_t *state;
+    game_sync_t *sync;
+    game_ext_t *ext;
+    size_t state_size;
+    int player_id;
+    int pipe_write_fd;
+
+    // Copia local, actualizada por sdk_sync
+    unsigned short width, height;
+    unsigned int player_count;
+    int *board;                            // width * height celdas
+    player_hot_t players[MAX_PLAYERS];     // Puntajes, posiciones y bloqueo de cada jugador
+    bool game_over;
+    uint64_t cursor;                       // Próxima secuencia del registro de cambios a aplicar
+    unsigned long long remaining_reward;   // Suma de las recompensas de las celdas libres
+    unsigned long free_cells;
+    uint64_t board_hash;                   // Hash Zobrist del tablero y las posiciones (zobrist.h)
+
+    // Estadísticas
+    unsigned long full_resyncs;
+    unsigned long long changes_applied;
+} player_sdk_t;
+
+// Se conecta a las memorias compartidas, identifica al jugador y copia el tablero. Retorna 0 o -1.
+int sdk_open(player_sdk_t *sdk);
+void sdk_close(player_sdk_t *sdk);
+
+// Actualiza la copia local dentro de reader_enter/reader_exit. Retorna 0 o -1.
+int sdk_sync(player_sdk_t *sdk);
+
+// Espera el turno del jugador y sincroniza. Retorna false si el juego terminó.
+bool sdk_wait_turn(player_sdk_t *sdk);
+
+// Envía un movimiento (0-7) al master. Retorna 0 o -1 si el master cerró el pipe.
+int sdk_send_move(player_sdk_t *sdk, unsigned char direction);
+
+static inline int sdk_cell(const player_sdk_t *sdk, int x, int y)
+{
+    return sdk->board[(size_t)y * sdk->width + x];
+}
+
+static inline void sdk_position(const player_sdk_t *sdk, int *x, int *y)
+{
+    *x = sdk->players[sdk->player_id].pos_x;
+    *y = sdk->players[sdk->player_id].pos_y;
+}
+
+static inline unsigned long long sdk_remaining_reward(const player_sdk_t *sdk)
+{
+    return sdk->remaining_reward;
+}
+
+// Máscara de las direcciones (bit d = dirección d) que llevan a una celda libre desde (x, y)
+unsigned char sdk_free_neighbors(const player_sdk_t *sdk, int x, int y);
+
+#endif
@@ -0,0 +1,127 @@
+#include "reap_utils.h"
+#include "clock_utils.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+#define REAP_POLL_MS 10 // Intervalo de sondeo sin pidfd
+
+static int open_pidfd(pid_t pid) {
+#ifdef SYS_pidfd_open
+    return (int)syscall(SYS_pidfd_open, pid, 0);
+#else
+    (void)pid;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+void reap_target_init(reap_target_t *target, pid_t pid, const char *label) {
+    memset(target, 0, sizeof(*target));
+    target->usage.pid = pid;
+    snprintf(target->usage.label, sizeof(target->usage.label), "%s", label);
+}
+
+// Recolecta sin bloquear a los que ya terminaron. Retorna cuántos quedan pendientes.
+static int collect_exited(reap_target_t targets[], int count) {
+    int pending = 0;
+    for (int i = 0; i < count; ++i) {
+        reap_target_t *t = &targets[i];
+        if (t->usage.collected || t->usage.pid <= 0) {
+            continue;
+        }
+        pid_t result = wait4(t->usage.pid, &t->status, WNOHANG, &t->usage.usage);
+        if (result == t->usage.pid) {
+            t->usage.collected = true;
+        } else if (result == -1 && errno != EINTR) {
+            perror("wait4");
+            t->usage.pid = -t->usage.pid; // No es un hijo esperable: no reintentar
+        } else {
+            pending++;
+        }
+    }
+    return pending;
+}
+
+// Espera hasta deadline (ms de CLOCK_MONOTONIC) a que terminen todos. Retorna cuántos quedan pendientes.
+static int wait_until(reap_target_t targets[], int count, const int pidfds[], uint64_t deadline) {
+    struct pollfd fds[count > 0 ? count : 1];
+    for (;;) {
+        int pending = collect_exited(targets, count);
+        uint64_t now = monotonic_ms();
+        if (pending == 0 || now >= deadline) {
+            return pending;
+        }
+        int timeout = (int)(deadline - now);
+
+        int nfds = 0;
+        bool all_pidfds = true;
+        for (int i = 0; i < count; ++i) {
+            if (targets[i].usage.collected || targets[i].usage.pid <= 0) {
+                continue;
+            }
+            if (pidfds[i] < 0) {
+                all_pidfds = false;
+                continue;
+            }
+            fds[nfds].fd = pidfds[i];
+            fds[nfds].events = POLLIN;
+            nfds++;
+        }
+        if (!all_pidfds && timeout > REAP_POLL_MS) {
+            timeout = REAP_POLL_MS;
+        }
+        if (poll(fds, nfds, timeout) == -1 && errno != EINTR) {
+            perror("poll");
+            return pending;
+        }
+    }
+}
+
+static void signal_pending(reap_target_t targets[], int count, int sig) {
+    for (int i = 0; i < count; ++i) {
+        reap_target_t *t = &targets[i];
+        if (!t->usage.collected && t->usage.pid > 0) {
+            if (kill(t->usage.pid, sig) == -1 && errno != ESRCH) {
+                perror("kill");
+            }
+            t->last_signal = sig;
+        }
+    }
+}
+
+int reap_processes(reap_target_t targets[], int count, unsigned int grace_ms, unsigned int term_ms) {
+    int pidfds[count > 0 ? count : 1];
+    for (int i = 0; i < count; ++i) {
+        pidfds[i] = targets[i].usage.pid > 0 ? open_pidfd(targets[i].usage.pid) : -1;
+    }
+
+    int pending = wait_until(targets, count, pidfds, monotonic_ms() + grace_ms);
+    if (pending > 0) {
+        fprintf(stderr, "Advertencia: %d proceso(s) no terminaron en %u ms, enviando SIGTERM\n", pending, grace_ms);
+        signal_pending(targets, count, SIGTERM);
+        pending = wait_until(targets, count, pidfds, monotonic_ms() + term_ms);
+    }
+    if (pending > 0) {
+        fprintf(stderr, "Advertencia: %d proceso(s) ignoraron SIGTERM, enviando SIGKILL\n", pending);
+        signal_pending(targets, count, SIGKILL);
+        pending = wait_until(targets, count, pidfds, monotonic_ms() + REAP_KILL_WAIT_MS);
+    }
+
+    for (int i = 0; i < count; ++i) {
+        if (pidfds[i] >= 0) {
+            close(pidfds[i]);
+        }
+        if (targets[i].usage.pid < 0) {
+            targets[i].usage.pid = -targets[i].usage.pid;
+        }
+    }
+    return pending;
+}
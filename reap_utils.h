@@ -0,0 +1,44 @@
+#ifndef REAP_UTILS_H
+#define REAP_UTILS_H
+
+#include "sched_utils.h"
+#include <stdbool.h>
+#include <sys/types.h>
+
+/*
+ * Recolección de los hijos al terminar el juego con un plazo acotado. Todos los procesos se esperan a la
+ * vez (poll sobre pidfds, o sondeo con WNOHANG si el kernel no tiene pidfd_open):
+ *
+ * 1. Hasta grace_ms para que terminen solos.
+ * 2. SIGTERM a los que quedan y hasta term_ms más.
+ * 3. SIGKILL y hasta REAP_KILL_WAIT_MS más. Un proceso que ni así termina (por ejemplo, en espera no
+ *    interrumpible) queda sin recolectar y se informa como tal.
+ */
+
+#define DEFAULT_SHUTDOWN_MS 2000
+#define SHUTDOWN_TERM_MS 500
+#define REAP_KILL_WAIT_MS 1000
+
+typedef struct
+{
+    process_usage_t usage; // pid, etiqueta y consumo (wait4)
+    int status;            // Estado de wait4, válido si usage.collected
+    int last_signal;       // 0, SIGTERM o SIGKILL: última señal enviada por el master
+} reap_target_t;
+
+// Inicializa un proceso a recolectar
+void reap_target_init(reap_target_t *target, pid_t pid, const char *label);
+
+/**
+ * Recolecta todos los procesos con escalamiento SIGTERM -> SIGKILL.
+ *
+ * @param targets Procesos a recolectar
+ * @param count Cantidad de procesos
+ * @param grace_ms Plazo para que terminen solos
+ * @param term_ms Plazo luego de SIGTERM
+ *
+ * @return Cantidad de procesos que no se pudieron recolectar
+ */
+int reap_processes(reap_target_t targets[], int count, unsigned int grace_ms, unsigned int term_ms);
+
+#endif
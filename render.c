@@ -0,0 +1,559 @@
+#include "shared_memory.h"
+#include "sync_utils.h"
+#include "board_access.h"
+#include "event_ring.h"
+#include "spectator_replica.h"
+#include "color_scheme.h"
+#include "clock_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+
+/*
+ * Exportador de frames sin terminal, para armar videos de una partida sin mirarla en vivo. Usa los
+ * colores de la vista (color_scheme.h): cada celda es un cuadrado de -z píxeles, las celdas libres en verde
+ * más intenso cuanto mayor su recompensa y las capturadas del color de su jugador, con un punto negro en
+ * la cabeza de cada jugador (blanco si está bloqueado).
+ *
+ * Uso: render (-i grabacion | -l) (-o directorio | -O archivo) [-z escala] [-e paso] [-T hilos]
+ *   -i  lee una grabación de spectator -o
+ *   -l  sigue la partida en curso por /game_state y el anillo de eventos de /game_ext
+ *   -o  escribe un PPM por frame (directorio/frame_000000.ppm, ...)
+ *   -O  escribe todos los frames seguidos en RGB24 ("-" = salida estándar), por ejemplo para
+ *       ffmpeg -f rawvideo -pix_fmt rgb24 -s ANCHOxALTO -r 30 -i partida.rgb partida.mp4
+ *   -e  frames de la grabación (o eventos, con -l) entre frames exportados (por defecto 1)
+ *   -T  hilos de dibujo (por defecto los procesadores en línea)
+ *
+ * Un hilo lee la partida y encola fotos del tablero en un anillo de RENDER_SLOTS_PER_THREAD * hilos
+ * lugares; el pool las dibuja en paralelo y, con -o, cada hilo escribe su archivo. Con -O el hilo
+ * principal escribe los frames en orden a medida que reutiliza los lugares.
+ */
+
+#define DEFAULT_SCALE 4
+#define MAX_SCALE 64
+#define MAX_THREADS 64
+#define RENDER_SLOTS_PER_THREAD 2
+#define POLL_INTERVAL_US 1000
+
+typedef enum
+{
+    SLOT_FREE,
+    SLOT_PENDING,   // Foto cargada, esperando un hilo
+    SLOT_RENDERING,
+    SLOT_DONE       // Dibujado, falta escribirlo (con -O) o liberarlo
+} slot_state_t;
+
+typedef struct
+{
+    slot_state_t state;
+    unsigned long frame;
+    int8_t *cells;
+    spectator_player_t players[SPECTATOR_MAX_PLAYERS];
+    unsigned int player_count;
+    unsigned char *pixels;
+    bool failed;
+} render_slot_t;
+
+typedef struct
+{
+    pthread_t tids[MAX_THREADS];
+    int threads;
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond; // Hay fotos pendientes o hay que terminar
+    pthread_cond_t done_cond; // Un frame terminó de dibujarse
+    render_slot_t *slots;
+    int slot_count;
+    unsigned long next_render; // Próximo frame a tomar por un hilo
+    unsigned long submitted;   // Frames encolados
+    bool shutdown;
+
+    uint16_t width, height;
+    int scale;
+    size_t frame_bytes;
+    const char *out_dir; // -o
+    FILE *out_raw;       // -O
+    bool write_failed;
+} render_pool_t;
+
+// Variables globales
+game_state_t *game_state = NULL;
+game_sync_t *game_sync = NULL;
+game_ext_t *game_ext = NULL;
+size_t game_state_size = 0;
+volatile sig_atomic_t stop_requested = 0;
+
+static void signal_handler(int sig)
+{
+    (void)sig;
+    stop_requested = 1;
+}
+
+static void fill_rgb(unsigned char *dst, const unsigned char *rgb, int count)
+{
+    for (int i = 0; i < count; ++i, dst += 3)
+    {
+        dst[0] = rgb[0];
+        dst[1] = rgb[1];
+        dst[2] = rgb[2];
+    }
+}
+
+static void cell_rgb(int8_t value, unsigned int player_count, unsigned char rgb[3])
+{
+    if (value > 0)
+    {
+        // Verde de COLOR_BOARD_BG, más oscuro cuanto menor la recompensa
+        const unsigned char *green = ansi_rgb(color_pair_def(COLOR_BOARD_BG)->bg);
+        int shade = 96 + 160 * (value > 9 ? 9 : value) / 9;
+        for (int c = 0; c < 3; ++c)
+            rgb[c] = (unsigned char)(green[c] * shade / 256);
+        return;
+    }
+    unsigned int owner = (unsigned int)-value;
+    int pair = owner < player_count ? player_color_pair(owner) : COLOR_CAPTURED;
+    memcpy(rgb, ansi_rgb(color_pair_def(pair)->bg), 3);
+}
+
+static void render_frame(const render_pool_t *pool, const render_slot_t *slot)
+{
+    int scale = pool->scale;
+    size_t row_bytes = (size_t)pool->width * scale * 3;
+    for (unsigned short y = 0; y < pool->height; ++y)
+    {
+        unsigned char *row = slot->pixels + (size_t)y * scale * row_bytes;
+        for (unsigned short x = 0; x < pool->width; ++x)
+        {
+            unsigned char rgb[3];
+            cell_rgb(slot->cells[(size_t)y * pool->width + x], slot->player_count, rgb);
+            fill_rgb(row + (size_t)x * scale * 3, rgb, scale);
+        }
+        // Las demás filas de píxeles de la celda son iguales a la primera
+        for (int r = 1; r < scale; ++r)
+            memcpy(row + r * row_bytes, row, row_bytes);
+    }
+
+    // Cabezas: un cuadrado central con el color de frente del par del jugador
+    int margin = scale / 4;
+    int inner = scale - 2 * margin;
+    for (unsigned int i = 0; i < slot->player_count && scale >= 3; ++i)
+    {
+        const spectator_player_t *p = &slot->players[i];
+        if (p->x >= pool->width || p->y >= pool->height)
+            continue;
+        int pair = p->blocked ? COLOR_SCORE : player_color_pair(i);
+        const unsigned char *rgb = ansi_rgb(color_pair_def(pair)->fg);
+        for (int r = 0; r < inner; ++r)
+        {
+            size_t py = (size_t)p->y * scale + margin + r;
+            fill_rgb(slot->pixels + py * row_bytes + ((size_t)p->x * scale + margin) * 3, rgb, inner);
+        }
+    }
+}
+
+static int write_ppm(const render_pool_t *pool, const render_slot_t *slot)
+{
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/frame_%06lu.ppm", pool->out_dir, slot->frame);
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    fprintf(f, "P6\n%d %d\n255\n", pool->width * pool->scale, pool->height * pool->scale);
+    size_t written = fwrite(slot->pixels, 1, pool->frame_bytes, f);
+    if (fclose(f) != 0 || written != pool->frame_bytes)
+    {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+static void *render_worker(void *arg)
+{
+    render_pool_t *pool = arg;
+    pthread_mutex_lock(&pool->mutex);
+    for (;;)
+    {
+        while (!pool->shutdown && pool->next_render == pool->submitted)
+            pthread_cond_wait(&pool->work_cond, &pool->mutex);
+        if (pool->next_render == pool->submitted)
+            break;
+        render_slot_t *slot = &pool->slots[pool->next_render++ % pool->slot_count];
+        slot->state = SLOT_RENDERING;
+        pthread_mutex_unlock(&pool->mutex);
+
+        render_frame(pool, slot);
+        slot->failed = pool->out_dir != NULL && write_ppm(pool, slot) != 0;
+
+        pthread_mutex_lock(&pool->mutex);
+        slot->state = SLOT_DONE;
+        pthread_cond_broadcast(&pool->done_cond);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+// Espera a que el frame del lugar termine y, con -O, lo escribe. Se llama con el mutex tomado.
+static void retire_slot(render_pool_t *pool, render_slot_t *slot)
+{
+    while (slot->state == SLOT_PENDING || slot->state == SLOT_RENDERING)
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    if (slot->state != SLOT_DONE)
+        return;
+
+    pthread_mutex_unlock(&pool->mutex);
+    if (slot->failed)
+        pool->write_failed = true;
+    else if (pool->out_raw != NULL && fwrite(slot->pixels, 1, pool->frame_bytes, pool->out_raw) != pool->frame_bytes)
+    {
+        perror("fwrite");
+        pool->write_failed = true;
+    }
+    pthread_mutex_lock(&pool->mutex);
+    slot->state = SLOT_FREE;
+}
+
+static int render_pool_init(render_pool_t *pool, int threads, uint16_t width, uint16_t height, int scale)
+{
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+    pool->width = width;
+    pool->height = height;
+    pool->scale = scale;
+    pool->frame_bytes = (size_t)width * scale * height * scale * 3;
+    pool->slot_count = threads * RENDER_SLOTS_PER_THREAD;
+    pool->slots = calloc(pool->slot_count, sizeof(render_slot_t));
+    if (pool->slots == NULL)
+    {
+        perror("calloc (frames)");
+        return -1;
+    }
+    for (int i = 0; i < pool->slot_count; ++i)
+    {
+        pool->slots[i].cells = malloc((size_t)width * height);
+        pool->slots[i].pixels = malloc(pool->frame_bytes);
+        if (pool->slots[i].cells == NULL || pool->slots[i].pixels == NULL)
+        {
+            perror("malloc (frames)");
+            return -1;
+        }
+    }
+
+    for (int i = 0; i < threads; ++i)
+    {
+        if (pthread_create(&pool->tids[i], NULL, render_worker, pool) != 0)
+        {
+            perror("pthread_create");
+            return -1;
+        }
+        pool->threads = i + 1;
+    }
+    return 0;
+}
+
+// Encola una foto del tablero; bloquea si todos los lugares están ocupados
+static void render_pool_submit(render_pool_t *pool, const int8_t *cells, const spectator_player_t *players,
+                               unsigned int player_count)
+{
+    pthread_mutex_lock(&pool->mutex);
+    render_slot_t *slot = &pool->slots[pool->submitted % pool->slot_count];
+    retire_slot(pool, slot);
+    pthread_mutex_unlock(&pool->mutex);
+
+    // El lugar está libre: ningún hilo lo toca hasta que se publique
+    slot->frame = pool->submitted;
+    memcpy(slot->cells, cells, (size_t)pool->width * pool->height);
+    memcpy(slot->players, players, player_count * sizeof(spectator_player_t));
+    slot->player_count = player_count;
+
+    pthread_mutex_lock(&pool->mutex);
+    slot->state = SLOT_PENDING;
+    pool->submitted++;
+    pthread_cond_signal(&pool->work_cond);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+static void render_pool_finish(render_pool_t *pool)
+{
+    if (pool->slots == NULL)
+        return;
+    pthread_mutex_lock(&pool->mutex);
+    unsigned long first = pool->submitted > (unsigned long)pool->slot_count ? pool->submitted - pool->slot_count : 0;
+    for (unsigned long frame = first; frame < pool->submitted; ++frame)
+        retire_slot(pool, &pool->slots[frame % pool->slot_count]);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int i = 0; i < pool->threads; ++i)
+        pthread_join(pool->tids[i], NULL);
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_cond_destroy(&pool->done_cond);
+    for (int i = 0; i < pool->slot_count; ++i)
+    {
+        free(pool->slots[i].cells);
+        free(pool->slots[i].pixels);
+    }
+    free(pool->slots);
+    pool->slots = NULL;
+}
+
+// Exporta una grabación de spectator -o
+static int render_recording(const char *path, render_pool_t *pool, int threads, int scale, unsigned int step)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        perror(path);
+        return -1;
+    }
+
+    spectator_replica_t replica = {0};
+    char *body = NULL;
+    size_t body_cap = 0;
+    unsigned long frames = 0;
+    bool pending = false; // La copia tiene cambios sin exportar
+    int result = 0;
+    while (!stop_requested)
+    {
+        spectator_frame_t frame;
+        int r = spectator_frame_read(fd, &frame, &body, &body_cap);
+        if (r == 1 || (r == 0 && frame.type == SPECTATOR_END))
+            break;
+        if (r == -1 || spectator_replica_apply(&replica, &frame, body, frame.size - sizeof(frame)) != 0)
+        {
+            fprintf(stderr, "Error: grabación inválida o truncada (frame %lu)\n", frames);
+            result = -1;
+            break;
+        }
+        if (frame.type != SPECTATOR_KEYFRAME && frame.type != SPECTATOR_DELTA)
+            continue;
+
+        if (pool->slots == NULL)
+        {
+            if (render_pool_init(pool, threads, replica.width, replica.height, scale) != 0)
+            {
+                result = -1;
+                break;
+            }
+        }
+        else if (replica.width != pool->width || replica.height != pool->height)
+        {
+            fprintf(stderr, "Error: la grabación cambia de tamaño de tablero\n");
+            result = -1;
+            break;
+        }
+
+        pending = true;
+        if (frames++ % step == 0)
+        {
+            render_pool_submit(pool, replica.cells, replica.players, replica.player_count);
+            pending = false;
+        }
+    }
+    // El último estado siempre se exporta
+    if (result == 0 && pending)
+        render_pool_submit(pool, replica.cells, replica.players, replica.player_count);
+
+    free(body);
+    spectator_replica_free(&replica);
+    close(fd);
+    return result;
+}
+
+static int attach_shared_memory(void)
+{
+    if (attach_game(&game_state, &game_state_size, &game_sync, &game_ext) != 0)
+        return -1;
+    if (game_ext->lock_mode == LOCK_MODE_ROBUST)
+        sync_use_robust_lock(&game_ext->robust_lock);
+    return 0;
+}
+
+static void detach_shared_memory(void)
+{
+    if (game_ext != NULL)
+        sync_release_robust_lock();
+    detach_game(&game_state, game_state_size, &game_sync, &game_ext);
+}
+
+// Copia el tablero y los jugadores bajo el lock de lectura. Retorna la cantidad de eventos incluidos.
+static uint64_t take_snapshot(int8_t *cells, spectator_player_t *players, unsigned int player_count, bool *game_over)
+{
+    const game_state_t *state = game_state;
+    reader_enter(game_sync);
+    for (unsigned short y = 0; y < state->board_height; ++y)
+        for (unsigned short x = 0; x < state->board_width; ++x)
+            cells[(size_t)y * state->board_width + x] = (int8_t)BOARD_CELL(state, x, y);
+    for (unsigned int i = 0; i < player_count; ++i)
+    {
+        const player_hot_t *hot = PLAYER_HOT(state, i);
+        players[i].x = hot->pos_x;
+        players[i].y = hot->pos_y;
+        players[i].score = hot->score;
+        players[i].blocked = hot->is_blocked;
+    }
+    uint64_t head = event_ring_head(&game_ext->events);
+    *game_over = state->game_over;
+    reader_exit(game_sync);
+    return head;
+}
+
+// Exporta la partida en curso: un frame cada step eventos del anillo y uno con el estado final
+static int render_live(render_pool_t *pool, int threads, int scale, unsigned int step)
+{
+    if (attach_shared_memory() != 0)
+    {
+        detach_shared_memory();
+        return -1;
+    }
+    uint16_t width = game_state->board_width, height = game_state->board_height;
+    unsigned int player_count = game_state->player_count < SPECTATOR_MAX_PLAYERS ? game_state->player_count
+                                                                                  : SPECTATOR_MAX_PLAYERS;
+    int8_t *cells = malloc((size_t)width * height);
+    spectator_player_t players[SPECTATOR_MAX_PLAYERS];
+    memset(players, 0, sizeof(players));
+    if (cells == NULL || render_pool_init(pool, threads, width, height, scale) != 0)
+    {
+        free(cells);
+        detach_shared_memory();
+        return -1;
+    }
+
+    bool game_over = false;
+    uint64_t last = take_snapshot(cells, players, player_count, &game_over);
+    render_pool_submit(pool, cells, players, player_count);
+    while (!game_over && !stop_requested)
+    {
+        uint64_t head = event_ring_head(&game_ext->events);
+        bool over = __atomic_load_n(&game_state->game_over, __ATOMIC_ACQUIRE);
+        if (head - last >= step || (over && head != last))
+        {
+            last = take_snapshot(cells, players, player_count, &game_over);
+            render_pool_submit(pool, cells, players, player_count);
+            continue;
+        }
+        game_over = over;
+        usleep(POLL_INTERVAL_US);
+    }
+
+    free(cells);
+    detach_shared_memory();
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *input_path = NULL;
+    const char *out_dir = NULL;
+    const char *out_raw = NULL;
+    bool live = false;
+    int scale = DEFAULT_SCALE;
+    unsigned int step = 1;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+    while ((opt = getopt(argc, argv, "i:lo:O:z:e:T:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'i':
+            input_path = optarg;
+            break;
+        case 'l':
+            live = true;
+            break;
+        case 'o':
+            out_dir = optarg;
+            break;
+        case 'O':
+            out_raw = optarg;
+            break;
+        case 'z':
+            scale = atoi(optarg);
+            if (scale < 1 || scale > MAX_SCALE)
+            {
+                fprintf(stderr, "Error: escala inválida '%s' (1-%d)\n", optarg, MAX_SCALE);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'e':
+            step = (unsigned int)atoi(optarg);
+            if (step == 0)
+            {
+                fprintf(stderr, "Error: paso inválido '%s'\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'T':
+            threads = atol(optarg);
+            if (threads < 1 || threads > MAX_THREADS)
+            {
+                fprintf(stderr, "Error: cantidad de hilos inválida '%s' (1-%d)\n", optarg, MAX_THREADS);
+                return EXIT_FAILURE;
+            }
+            break;
+        default:
+            live = false;
+            input_path = NULL;
+            break;
+        }
+    }
+    if ((input_path == NULL) == !live || (out_dir == NULL) == (out_raw == NULL))
+    {
+        fprintf(stderr, "Uso: %s (-i grabacion | -l) (-o directorio | -O archivo) [-z escala] [-e paso] [-T hilos]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (threads < 1)
+        threads = 1;
+    if (threads > MAX_THREADS)
+        threads = MAX_THREADS;
+
+    struct sigaction sa;
+    sa.sa_handler = signal_handler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = 0;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    render_pool_t pool;
+    memset(&pool, 0, sizeof(pool));
+    pool.out_dir = out_dir;
+    if (out_raw != NULL)
+    {
+        pool.out_raw = strcmp(out_raw, "-") == 0 ? stdout : fopen(out_raw, "wb");
+        if (pool.out_raw == NULL)
+        {
+            perror(out_raw);
+            return EXIT_FAILURE;
+        }
+    }
+
+    double start = monotonic_ns() / 1e9;
+    int result = live ? render_live(&pool, (int)threads, scale, step)
+                      : render_recording(input_path, &pool, (int)threads, scale, step);
+    unsigned long frames = pool.submitted;
+    render_pool_finish(&pool);
+    double elapsed = monotonic_ns() / 1e9 - start;
+
+    if (pool.out_raw != NULL && pool.out_raw != stdout && fclose(pool.out_raw) != 0)
+    {
+        perror(out_raw);
+        pool.write_failed = true;
+    }
+    else if (pool.out_raw == stdout)
+        fflush(stdout);
+
+    fprintf(stderr, "render: %lu frames of %dx%d in %.2f s (%.0f frames/s, %ld threads)\n", frames,
+            pool.width * scale, pool.height * scale, elapsed, elapsed > 0 ? frames / elapsed : 0.0, threads);
+    return result == 0 && !pool.write_failed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,123 @@
+#include "response_monitor.h"
+#include "clock_utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+int parse_eviction_policy(const char *spec, eviction_policy_t *policy) {
+    const char *rest;
+    if (strncmp(spec, "block:", 6) == 0) {
+        policy->action = EVICT_BLOCK;
+        rest = spec + 6;
+    } else if (strncmp(spec, "skip:", 5) == 0) {
+        policy->action = EVICT_SKIP;
+        rest = spec + 5;
+    } else {
+        return -1;
+    }
+
+    char *end;
+    long deadline = strtol(rest, &end, 10);
+    if (end == rest || deadline < 1 || deadline > 3600000) {
+        return -1;
+    }
+    policy->deadline_ms = (unsigned int)deadline;
+    policy->max_misses = DEFAULT_MAX_MISSES;
+    if (*end == ':') {
+        const char *misses_str = end + 1;
+        long misses = strtol(misses_str, &end, 10);
+        if (end == misses_str || misses < 1 || misses > 1000000) {
+            return -1;
+        }
+        policy->max_misses = (unsigned int)misses;
+    }
+    return *end == '\0' ? 0 : -1;
+}
+
+void response_monitor_init(response_monitor_t *monitor, const eviction_policy_t *policy, int num_players) {
+    memset(monitor, 0, sizeof(*monitor));
+    monitor->policy = *policy;
+    monitor->num_players = num_players;
+    for (int i = 0; i < num_players; ++i) {
+        latency_hist_reset(&monitor->players[i].hist);
+    }
+}
+
+void response_monitor_grant(response_monitor_t *monitor, int player_idx) {
+    player_monitor_t *p = &monitor->players[player_idx];
+    if (p->grant_count == MONITOR_QUEUE) {
+        // No debería pasar con créditos <= MAX_CREDIT_DEPTH; se pierde la marca más vieja
+        p->grant_head = (p->grant_head + 1) % MONITOR_QUEUE;
+        p->grant_count--;
+    }
+    unsigned int slot = (p->grant_head + p->grant_count) % MONITOR_QUEUE;
+    p->grants[slot] = monotonic_ns();
+    p->grant_paced[slot] = monitor->paced_ns;
+    p->grant_count++;
+}
+
+void response_monitor_pacing_begin(response_monitor_t *monitor) {
+    if (monitor->pacing_since == 0) {
+        monitor->pacing_since = monotonic_ns();
+    }
+}
+
+void response_monitor_pacing_end(response_monitor_t *monitor) {
+    if (monitor->pacing_since != 0) {
+        monitor->paced_ns += monotonic_ns() - monitor->pacing_since;
+        monitor->pacing_since = 0;
+    }
+}
+
+static bool over_threshold(const response_monitor_t *monitor, const player_monitor_t *p) {
+    const eviction_policy_t *policy = &monitor->policy;
+    if (p->consecutive_misses >= policy->max_misses) {
+        return true;
+    }
+    return p->hist.total >= MONITOR_MIN_SAMPLES &&
+           latency_hist_percentile(&p->hist, 99) > (uint64_t)policy->deadline_ms * 1000;
+}
+
+bool response_monitor_arrival(response_monitor_t *monitor, int player_idx, unsigned int consumed) {
+    player_monitor_t *p = &monitor->players[player_idx];
+    if (p->evicted) {
+        return false;
+    }
+
+    uint64_t now = monotonic_ns();
+    uint64_t deadline_us = (uint64_t)monitor->policy.deadline_ms * 1000;
+    // Un jugador que escribe sin esperar créditos no tiene marcas pendientes: no hay respuesta que medir
+    for (unsigned int c = 0; c < consumed && p->grant_count > 0; ++c) {
+        uint64_t elapsed = now - p->grants[p->grant_head];
+        uint64_t paced = monitor->paced_ns - p->grant_paced[p->grant_head];
+        uint64_t response_us = (elapsed > paced ? elapsed - paced : 0) / 1000;
+        p->grant_head = (p->grant_head + 1) % MONITOR_QUEUE;
+        p->grant_count--;
+        latency_hist_record(&p->hist, response_us);
+
+        if (monitor->policy.action != EVICT_NONE && response_us > deadline_us) {
+            p->misses++;
+            p->consecutive_misses++;
+        } else {
+            p->consecutive_misses = 0;
+        }
+    }
+
+    if (monitor->policy.action == EVICT_NONE || !over_threshold(monitor, p)) {
+        return true;
+    }
+    if (monitor->policy.action == EVICT_BLOCK) {
+        p->evicted = true;
+    } else {
+        p->skipped++;
+    }
+    return false;
+}
+
+void response_monitor_print(const response_monitor_t *monitor, int player_idx) {
+    const player_monitor_t *p = &monitor->players[player_idx];
+    latency_hist_print(&p->hist, stdout, "  ");
+    if (monitor->policy.action != EVICT_NONE) {
+        printf("  deadline %u ms: %lu late responses, %lu skipped moves%s\n",
+               monitor->policy.deadline_ms, p->misses, p->skipped, p->evicted ? ", evicted" : "");
+    }
+}
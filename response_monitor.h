@@ -0,0 +1,93 @@
+#ifndef RESPONSE_MONITOR_H
+#define RESPONSE_MONITOR_H
+
+#include "shared_memory.h"
+#include "latency_hist.h"
+#include <stdint.h>
+
+/*
+ * Tiempos de respuesta de cada jugador, medidos por el master: desde que otorga un crédito
+ * (allow_player_move) hasta que lee del pipe el movimiento correspondiente. Los créditos de un jugador se
+ * consumen en orden, así que alcanza con una cola de marcas de tiempo por jugador. El tiempo que el master
+ * no lee movimientos por su propio ritmo (espera a la vista, demora -d, pausa del socket de control) se
+ * descuenta: sólo se cobra al jugador el tiempo en que el master podría haber leído su respuesta.
+ *
+ * Política de expulsión opcional (-E): una respuesta más lenta que deadline_ms es una demora. Si un jugador
+ * acumula max_misses demoras seguidas, o su p99 supera deadline_ms con al menos MONITOR_MIN_SAMPLES
+ * muestras, se lo bloquea (EVICT_BLOCK) o se descartan sus movimientos mientras siga en esa situación
+ * (EVICT_SKIP).
+ */
+
+#define MONITOR_QUEUE 64 // >= MAX_CREDIT_DEPTH
+#define MONITOR_MIN_SAMPLES 32
+#define DEFAULT_MAX_MISSES 3
+
+typedef enum
+{
+    EVICT_NONE,
+    EVICT_BLOCK, // El jugador queda bloqueado hasta el final del juego
+    EVICT_SKIP   // Se descartan sus movimientos mientras supere el umbral
+} evict_action_t;
+
+typedef struct
+{
+    evict_action_t action;
+    unsigned int deadline_ms;
+    unsigned int max_misses;
+} eviction_policy_t;
+
+typedef struct
+{
+    latency_hist_t hist;
+    uint64_t grants[MONITOR_QUEUE];      // Marcas de tiempo (ns) de los créditos pendientes
+    uint64_t grant_paced[MONITOR_QUEUE]; // paced_ns del monitor al otorgar cada crédito
+    unsigned int grant_head;
+    unsigned int grant_count;
+    unsigned int consecutive_misses;
+    unsigned long misses;
+    unsigned long skipped;
+    bool evicted;
+} player_monitor_t;
+
+typedef struct
+{
+    eviction_policy_t policy;
+    int num_players;
+    player_monitor_t players[MAX_PLAYERS];
+    uint64_t paced_ns;     // Tiempo total en que el master no leyó movimientos por su propio ritmo
+    uint64_t pacing_since; // Inicio del intervalo en curso (0 = fuera de un intervalo)
+} response_monitor_t;
+
+// Parsea "block:ms[:demoras]" o "skip:ms[:demoras]". Retorna 0 o -1.
+int parse_eviction_policy(const char *spec, eviction_policy_t *policy);
+
+void response_monitor_init(response_monitor_t *monitor, const eviction_policy_t *policy, int num_players);
+
+// Registra que se otorgó un crédito al jugador
+void response_monitor_grant(response_monitor_t *monitor, int player_idx);
+
+// Marcan un intervalo en que el master no lee movimientos por su propio ritmo (no se cobra a los jugadores)
+void response_monitor_pacing_begin(response_monitor_t *monitor);
+void response_monitor_pacing_end(response_monitor_t *monitor);
+
+/**
+ * Registra la llegada de movimientos del jugador y aplica la política de expulsión.
+ *
+ * @param monitor Monitor
+ * @param player_idx Índice del jugador
+ * @param consumed Movimientos leídos del pipe (cada uno consume un crédito)
+ *
+ * @return true si el movimiento debe procesarse, false si debe descartarse (jugador expulsado o en EVICT_SKIP)
+ */
+bool response_monitor_arrival(response_monitor_t *monitor, int player_idx, unsigned int consumed);
+
+// true si la política EVICT_BLOCK expulsó al jugador
+static inline bool response_monitor_evicted(const response_monitor_t *monitor, int player_idx)
+{
+    return monitor->players[player_idx].evicted;
+}
+
+// Imprime el histograma del jugador y, si corresponde, sus demoras y expulsión
+void response_monitor_print(const response_monitor_t *monitor, int player_idx);
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef REWARD_INDEX_H
+#define REWARD_INDEX_H
+
+#include "shared_memory.h"
+#include "board_access.h"
+#include <stdint.h>
+
+/*
+ * Árbol de Fenwick 2D de la recompensa que queda en el tablero, publicado por el master en /game_ext. Lo
+ * arma publish_game_ext en O(celdas) y process_player_move descuenta cada captura en O(log ancho * log
+ * alto). "Recompensa restante en el rectángulo R" cuesta lo mismo para cualquier proceso, en lugar de
+ * sumar board[] celda por celda.
+ *
+ * Acceso: una captura actualiza varios nodos, uno por uno, y una consulta lee varios, así que no alcanza
+ * con que cada nodo sea consistente: leer mientras el master escribe puede contar la captura sólo a
+ * medias. El master lo modifica dentro de writer_enter. Los lectores consultan dentro de reader_enter, o
+ * mientras el master espera el notify_view_done de la vista (como hace la vista al dibujar cada frame).
+ *
+ * Nodo (x, y), con índices de 0: suma de las celdas en (x - lowbit(x + 1), x] x (y - lowbit(y + 1), y].
+ */
+
+static inline size_t reward_index_size(unsigned short width, unsigned short height)
+{
+    return (size_t)width * height * sizeof(int64_t);
+}
+
+static inline int64_t *reward_index_nodes(game_ext_t *ext)
+{
+    return (int64_t *)((char *)ext + ext->reward_index_offset);
+}
+
+static inline const int64_t *reward_index_nodes_const(const game_ext_t *ext)
+{
+    return (const int64_t *)((const char *)ext + ext->reward_index_offset);
+}
+
+// Suma delta a la celda (x, y)
+static inline void reward_index_add(game_ext_t *ext, int x, int y, int64_t delta)
+{
+    int64_t *nodes = reward_index_nodes(ext);
+    for (int i = x + 1; i <= ext->board_width; i += i & -i)
+        for (int j = y + 1; j <= ext->board_height; j += j & -j)
+            nodes[(size_t)(j - 1) * ext->board_width + (i - 1)] += delta;
+}
+
+// Recompensa restante en [0, x) x [0, y)
+static inline int64_t reward_index_prefix(const game_ext_t *ext, int x, int y)
+{
+    if (x > ext->board_width)
+        x = ext->board_width;
+    if (y > ext->board_height)
+        y = ext->board_height;
+    const int64_t *nodes = reward_index_nodes_const(ext);
+    int64_t sum = 0;
+    for (int i = x; i > 0; i -= i & -i)
+        for (int j = y; j > 0; j -= j & -j)
+            sum += nodes[(size_t)(j - 1) * ext->board_width + (i - 1)];
+    return sum;
+}
+
+// Recompensa restante en el rectángulo [x0, x1) x [y0, y1); se recorta a los límites del tablero
+static inline int64_t reward_index_rect(const game_ext_t *ext, int x0, int y0, int x1, int y1)
+{
+    if (x0 < 0)
+        x0 = 0;
+    if (y0 < 0)
+        y0 = 0;
+    if (x0 >= x1 || y0 >= y1)
+        return 0;
+    return reward_index_prefix(ext, x1, y1) - reward_index_prefix(ext, x0, y1) -
+           reward_index_prefix(ext, x1, y0) + reward_index_prefix(ext, x0, y0);
+}
+
+static inline int64_t reward_index_total(const game_ext_t *ext)
+{
+    return reward_index_prefix(ext, ext->board_width, ext->board_height);
+}
+
+// Arma el árbol en O(celdas): cada nodo se propaga a su padre, primero por filas y luego por columnas
+static inline void reward_index_build(game_ext_t *ext, const game_state_t *state)
+{
+    int64_t *nodes = reward_index_nodes(ext);
+    int width = state->board_width, height = state->board_height;
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            int value = BOARD_CELL(state, x, y);
+            nodes[(size_t)y * width + x] = value > 0 ? value : 0;
+        }
+    }
+    for (int y = 0; y < height; ++y)
+    {
+        for (int i = 1; i <= width; ++i)
+        {
+            int parent = i + (i & -i);
+            if (parent <= width)
+                nodes[(size_t)y * width + (parent - 1)] += nodes[(size_t)y * width + (i - 1)];
+        }
+    }
+    for (int x = 0; x < width; ++x)
+    {
+        for (int j = 1; j <= height; ++j)
+        {
+            int parent = j + (j & -j);
+            if (parent <= height)
+                nodes[(size_t)(parent - 1) * width + x] += nodes[(size_t)(j - 1) * width + x];
+        }
+    }
+}
+
+#endif
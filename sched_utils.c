@@ -0,0 +1,390 @@
+#include "sched_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <signal.h>
+
+int parse_cpu_list(const char *list, cpu_set_t *set) {
+    CPU_ZERO(set);
+    const char *p = list;
+    while (*p != '\0') {
+        char *end;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 0 || first >= CPU_SETSIZE) {
+            return -1;
+        }
+        long last = first;
+        if (*end == '-') {
+            p = end + 1;
+            last = strtol(p, &end, 10);
+            if (end == p || last < first || last >= CPU_SETSIZE) {
+                return -1;
+            }
+        }
+        for (long cpu = first; cpu <= last; ++cpu) {
+            CPU_SET(cpu, set);
+        }
+        if (*end == ',') {
+            end++;
+        } else if (*end != '\0') {
+            return -1;
+        }
+        p = end;
+    }
+    return CPU_COUNT(set) > 0 ? 0 : -1;
+}
+
+int parse_cpu_sets(const char *spec, cpu_set_t sets[], int max_sets) {
+    char buf[256];
+    if (strlen(spec) >= sizeof(buf)) {
+        return -1;
+    }
+    strcpy(buf, spec);
+
+    int count = 0;
+    char *saveptr = NULL;
+    for (char *tok = strtok_r(buf, "/", &saveptr); tok != NULL; tok = strtok_r(NULL, "/", &saveptr)) {
+        if (count >= max_sets || parse_cpu_list(tok, &sets[count]) != 0) {
+            return -1;
+        }
+        count++;
+    }
+    return count > 0 ? count : -1;
+}
+
+int parse_sched_policy(const char *spec, sched_policy_t *policy) {
+    const char *colon = strchr(spec, ':');
+    if (colon == NULL) {
+        return -1;
+    }
+    char *end;
+    long value = strtol(colon + 1, &end, 10);
+    if (end == colon + 1 || *end != '\0') {
+        return -1;
+    }
+
+    size_t name_len = colon - spec;
+    policy->enabled = true;
+    policy->priority = 0;
+    policy->nice = 0;
+    if (name_len == 4 && strncmp(spec, "fifo", 4) == 0) {
+        policy->policy = SCHED_FIFO;
+        policy->priority = (int)value;
+    } else if (name_len == 2 && strncmp(spec, "rr", 2) == 0) {
+        policy->policy = SCHED_RR;
+        policy->priority = (int)value;
+    } else if (name_len == 4 && strncmp(spec, "nice", 4) == 0) {
+        policy->policy = SCHED_OTHER;
+        policy->nice = (int)value;
+    } else {
+        policy->enabled = false;
+        return -1;
+    }
+
+    if (policy->policy != SCHED_OTHER &&
+        (policy->priority < sched_get_priority_min(policy->policy) ||
+         policy->priority > sched_get_priority_max(policy->policy))) {
+        policy->enabled = false;
+        return -1;
+    }
+    return 0;
+}
+
+int apply_cpu_affinity(pid_t pid, const cpu_set_t *set) {
+    if (sched_setaffinity(pid, sizeof(cpu_set_t), set) == -1) {
+        perror("sched_setaffinity");
+        return -1;
+    }
+    return 0;
+}
+
+int apply_sched_policy(const sched_policy_t *policy) {
+    if (!policy->enabled) {
+        return 0;
+    }
+
+    if (policy->policy == SCHED_OTHER) {
+        if (setpriority(PRIO_PROCESS, 0, policy->nice) == -1) {
+            perror("setpriority");
+            return -1;
+        }
+        return 0;
+    }
+
+    // SCHED_RESET_ON_FORK: jugadores y vista arrancan con la política normal
+    struct sched_param param = { .sched_priority = policy->priority };
+    if (sched_setscheduler(0, policy->policy | SCHED_RESET_ON_FORK, &param) == -1) {
+        perror("sched_setscheduler");
+        return -1;
+    }
+    return 0;
+}
+
+static double timeval_ms(struct timeval tv) {
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+static int parse_limit_value(const char *value, long min, long max, long *out) {
+    char *end;
+    errno = 0;
+    long v = strtol(value, &end, 10);
+    if (errno != 0 || end == value || *end != '\0' || v < min || v > max) {
+        return -1;
+    }
+    *out = v;
+    return 0;
+}
+
+int parse_player_limits(const char *spec, player_limits_t *limits) {
+    char buf[1024];
+    if (strlen(spec) >= sizeof(buf)) {
+        return -1;
+    }
+    strcpy(buf, spec);
+
+    memset(limits, 0, sizeof(*limits));
+    char *save;
+    for (char *item = strtok_r(buf, ",", &save); item != NULL; item = strtok_r(NULL, ",", &save)) {
+        char *value = strchr(item, '=');
+        if (value == NULL) {
+            return -1;
+        }
+        *value++ = '\0';
+        long v;
+        if (strcmp(item, "cpu") == 0 && parse_limit_value(value, 1, 1000000, &v) == 0) {
+            limits->cpu_s = (rlim_t)v;
+        } else if (strcmp(item, "as") == 0 && parse_limit_value(value, 1, 1L << 30, &v) == 0) {
+            limits->as_bytes = (rlim_t)v << 20;
+        } else if (strcmp(item, "files") == 0 && parse_limit_value(value, 4, 1000000, &v) == 0) {
+            limits->files = (rlim_t)v;
+        } else if (strcmp(item, "nice") == 0 && parse_limit_value(value, -20, 19, &v) == 0) {
+            limits->nice_set = true;
+            limits->nice = (int)v;
+        } else if (strcmp(item, "mem") == 0 && parse_limit_value(value, 1, 1L << 30, &v) == 0) {
+            limits->mem_bytes = (unsigned long)v << 20;
+        } else if (strcmp(item, "cpu_pct") == 0 && parse_limit_value(value, 1, 100000, &v) == 0) {
+            limits->cpu_pct = (unsigned int)v;
+        } else if (strcmp(item, "cgroup") == 0 && *value != '\0') {
+            limits->cgroup = strdup(value); // Se usa hasta el final del juego
+            if (limits->cgroup == NULL) {
+                return -1;
+            }
+        } else {
+            return -1;
+        }
+    }
+    if ((limits->mem_bytes > 0 || limits->cpu_pct > 0) && limits->cgroup == NULL) {
+        return -1; // Son límites del cgroup
+    }
+    limits->enabled = true;
+    return 0;
+}
+
+int player_cgroup_path(const player_limits_t *limits, int player_idx, char *path, size_t size) {
+    if (!limits->enabled || limits->cgroup == NULL) {
+        return -1;
+    }
+    int n = snprintf(path, size, "%s/player%d-%d", limits->cgroup, player_idx, (int)getpid());
+    return n > 0 && (size_t)n < size ? 0 : -1;
+}
+
+// Escribe un archivo de interfaz del cgroup. Sin O_CREAT: si la ruta no es un cgroup, el archivo no existe
+// y se informa el error.
+static int write_cgroup_file(const char *dir, const char *file, const char *value) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%s", dir, file);
+    int fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return -1;
+    }
+    ssize_t len = (ssize_t)strlen(value);
+    ssize_t written = write(fd, value, len);
+    int saved_errno = errno;
+    close(fd);
+    errno = saved_errno;
+    return written == len ? 0 : -1;
+}
+
+int player_cgroup_create(const player_limits_t *limits, const char *path) {
+    // Los archivos memory.max y cpu.max aparecen en los hijos sólo si el padre delega esos controladores.
+    // Si ya están delegados o no se pueden delegar, el error se ve al escribir el límite.
+    if (limits->mem_bytes > 0 || limits->cpu_pct > 0) {
+        char controllers[32];
+        snprintf(controllers, sizeof(controllers), "%s%s\n", limits->mem_bytes > 0 ? "+memory " : "",
+                 limits->cpu_pct > 0 ? "+cpu" : "");
+        write_cgroup_file(limits->cgroup, "cgroup.subtree_control", controllers);
+    }
+
+    if (mkdir(path, 0755) == -1 && errno != EEXIST) {
+        fprintf(stderr, "Advertencia: no se pudo crear el cgroup '%s': %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    char value[64];
+    if (limits->mem_bytes > 0) {
+        snprintf(value, sizeof(value), "%lu\n", limits->mem_bytes);
+        if (write_cgroup_file(path, "memory.max", value) == -1) {
+            fprintf(stderr, "Advertencia: no se pudo escribir memory.max en '%s': %s\n", path, strerror(errno));
+            rmdir(path);
+            return -1;
+        }
+    }
+    if (limits->cpu_pct > 0) {
+        // Cuota por período de 100 ms: cpu_pct% de una CPU
+        snprintf(value, sizeof(value), "%u 100000\n", limits->cpu_pct * 1000);
+        if (write_cgroup_file(path, "cpu.max", value) == -1) {
+            fprintf(stderr, "Advertencia: no se pudo escribir cpu.max en '%s': %s\n", path, strerror(errno));
+            rmdir(path);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void player_cgroup_remove(const char *path) {
+    rmdir(path);
+}
+
+static int set_limit(int resource, rlim_t soft, rlim_t hard, const char *name) {
+    struct rlimit current;
+    if (getrlimit(resource, &current) == 0 && current.rlim_max != RLIM_INFINITY) {
+        // Sin privilegios no se puede subir el máximo actual
+        if (hard > current.rlim_max) {
+            hard = current.rlim_max;
+        }
+        if (soft > hard) {
+            soft = hard;
+        }
+    }
+    struct rlimit limit = {soft, hard};
+    if (setrlimit(resource, &limit) == -1) {
+        fprintf(stderr, "Advertencia: no se pudo limitar %s: %s\n", name, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+int apply_player_limits(const player_limits_t *limits, const char *cgroup_path) {
+    if (!limits->enabled) {
+        return 0;
+    }
+    int result = 0;
+
+    // El cgroup primero: los límites propios del proceso no afectan la escritura en cgroup.procs
+    if (cgroup_path != NULL) {
+        char pid[32];
+        snprintf(pid, sizeof(pid), "%d\n", (int)getpid());
+        if (write_cgroup_file(cgroup_path, "cgroup.procs", pid) == -1) {
+            fprintf(stderr, "Advertencia: no se pudo mover el jugador al cgroup '%s': %s\n", cgroup_path, strerror(errno));
+            result = -1;
+        }
+    }
+    if (limits->cpu_s > 0 && set_limit(RLIMIT_CPU, limits->cpu_s, limits->cpu_s + 1, "el tiempo de CPU") != 0) {
+        result = -1;
+    }
+    if (limits->as_bytes > 0 && set_limit(RLIMIT_AS, limits->as_bytes, limits->as_bytes, "el espacio de direcciones") != 0) {
+        result = -1;
+    }
+    if (limits->files > 0 && set_limit(RLIMIT_NOFILE, limits->files, limits->files, "los archivos abiertos") != 0) {
+        result = -1;
+    }
+    if (limits->nice_set && setpriority(PRIO_PROCESS, 0, limits->nice) == -1) {
+        fprintf(stderr, "Advertencia: no se pudo fijar nice %d: %s\n", limits->nice, strerror(errno));
+        result = -1;
+    }
+    return result;
+}
+
+// Cantidad de procesos del cgroup terminados por falta de memoria (memory.events), 0 si no se puede leer
+static unsigned long cgroup_oom_kills(const char *cgroup_path) {
+    char events[4096];
+    snprintf(events, sizeof(events), "%s/memory.events", cgroup_path);
+    FILE *f = fopen(events, "r");
+    if (f == NULL) {
+        return 0;
+    }
+    char key[64];
+    unsigned long value, kills = 0;
+    while (fscanf(f, "%63s %lu", key, &value) == 2) {
+        if (strcmp(key, "oom_kill") == 0) {
+            kills = value;
+        }
+    }
+    fclose(f);
+    return kills;
+}
+
+const char *player_limit_violation(const player_limits_t *limits, const char *cgroup_path, int status, const struct rusage *usage, int master_signal) {
+    if (limits == NULL || !limits->enabled || !WIFSIGNALED(status)) {
+        return NULL;
+    }
+    int sig = WTERMSIG(status);
+    // SIGXCPU sólo lo envía el kernel; un SIGKILL puede ser del master al recolectar a un jugador que no terminó
+    if (sig == SIGKILL && master_signal == SIGKILL) {
+        return NULL;
+    }
+    if (limits->cpu_s > 0) {
+        double cpu_ms = timeval_ms(usage->ru_utime) + timeval_ms(usage->ru_stime);
+        // SIGXCPU al llegar al límite; si el jugador lo ignora, el kernel lo mata con SIGKILL al máximo
+        if (sig == SIGXCPU || (sig == SIGKILL && cpu_ms >= limits->cpu_s * 1000.0)) {
+            return "CPU time limit";
+        }
+    }
+    if (sig == SIGKILL && cgroup_path != NULL && cgroup_oom_kills(cgroup_path) > 0) {
+        return "cgroup memory limit";
+    }
+    return NULL;
+}
+
+static void print_usage_row(const char *label, pid_t pid, const struct rusage *ru) {
+    char pid_str[16] = "-";
+    if (pid > 0) {
+        snprintf(pid_str, sizeof(pid_str), "%d", (int)pid);
+    }
+    printf("%-24s %7s %10.1f %10.1f %10ld %9ld %7ld %8ld %8ld\n", label, pid_str,
+           timeval_ms(ru->ru_utime), timeval_ms(ru->ru_stime), ru->ru_maxrss,
+           ru->ru_minflt, ru->ru_majflt, ru->ru_nvcsw, ru->ru_nivcsw);
+}
+
+static void add_usage(struct rusage *total, const struct rusage *ru) {
+    timeradd(&total->ru_utime, &ru->ru_utime, &total->ru_utime);
+    timeradd(&total->ru_stime, &ru->ru_stime, &total->ru_stime);
+    total->ru_maxrss += ru->ru_maxrss;
+    total->ru_minflt += ru->ru_minflt;
+    total->ru_majflt += ru->ru_majflt;
+    total->ru_nvcsw += ru->ru_nvcsw;
+    total->ru_nivcsw += ru->ru_nivcsw;
+}
+
+void print_usage_report(const process_usage_t children[], int count) {
+    struct rusage self;
+    if (getrusage(RUSAGE_SELF, &self) == -1) {
+        perror("getrusage");
+        return;
+    }
+
+    printf("Resource usage:\n");
+    printf("%-24s %7s %10s %10s %10s %9s %7s %8s %8s\n",
+           "process", "pid", "user_ms", "sys_ms", "maxrss_kb", "minflt", "majflt", "vcsw", "ivcsw");
+    struct rusage total;
+    memset(&total, 0, sizeof(total));
+    print_usage_row("master", getpid(), &self);
+    add_usage(&total, &self);
+    for (int i = 0; i < count; ++i) {
+        if (!children[i].collected) {
+            printf("%-24s %7d %10s\n", children[i].label, (int)children[i].pid, "not collected");
+            continue;
+        }
+        print_usage_row(children[i].label, children[i].pid, &children[i].usage);
+        add_usage(&total, &children[i].usage);
+    }
+    // El total de RSS es la suma de los máximos de cada proceso: una cota superior del pico conjunto
+    print_usage_row("total", 0, &total);
+}
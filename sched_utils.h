@@ -0,0 +1,118 @@
+#ifndef SCHED_UTILS_H
+#define SCHED_UTILS_H
+
+#include <sched.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#include <stddef.h>
+#include <sys/resource.h>
+
+// Política de planificación opcional para el master
+typedef struct
+{
+    bool enabled;
+    int policy;   // SCHED_OTHER, SCHED_FIFO o SCHED_RR
+    int priority; // Prioridad de tiempo real (solo FIFO/RR)
+    int nice;     // Valor nice (solo SCHED_OTHER)
+} sched_policy_t;
+
+// Límites de recursos de cada jugador (-R), aplicados en el hijo antes de execl
+typedef struct
+{
+    bool enabled;
+    rlim_t cpu_s;       // RLIMIT_CPU en segundos: SIGXCPU al llegar y SIGKILL un segundo después (0 = sin límite)
+    rlim_t as_bytes;    // RLIMIT_AS (0 = sin límite)
+    rlim_t files;       // RLIMIT_NOFILE (0 = sin límite)
+    bool nice_set;
+    int nice;
+    const char *cgroup;      // Directorio cgroup v2 bajo el que se crea un cgroup por jugador (NULL = sin cgroup)
+    unsigned long mem_bytes; // memory.max del cgroup del jugador (0 = sin límite)
+    unsigned int cpu_pct;    // cpu.max del cgroup del jugador, en porcentaje de una CPU (0 = sin límite)
+} player_limits_t;
+
+// Parsea una lista de CPUs del estilo "0-3,6". Retorna 0 o -1.
+int parse_cpu_list(const char *list, cpu_set_t *set);
+
+// Parsea varios conjuntos separados por '/' ("0-1/2/3"). Retorna la cantidad de conjuntos o -1.
+int parse_cpu_sets(const char *spec, cpu_set_t sets[], int max_sets);
+
+// Parsea "fifo:prio", "rr:prio" o "nice:valor". Retorna 0 o -1.
+int parse_sched_policy(const char *spec, sched_policy_t *policy);
+
+// Fija la afinidad del proceso pid (0 para el proceso actual). Retorna 0 o -1.
+int apply_cpu_affinity(pid_t pid, const cpu_set_t *set);
+
+// Aplica la política al proceso actual. Los hijos creados después no heredan la prioridad de tiempo real (sí el nice). Retorna 0 o -1.
+int apply_sched_policy(const sched_policy_t *policy);
+
+// Parsea "cpu=S,as=MiB,files=N,nice=N,cgroup=ruta,mem=MiB,cpu_pct=N" (cualquier subconjunto; mem y
+// cpu_pct requieren cgroup). Retorna 0 o -1.
+int parse_player_limits(const char *spec, player_limits_t *limits);
+
+/**
+ * Ruta del cgroup del jugador: limits->cgroup/player<i>-<pid del master>. Sólo se puede llamar desde el
+ * master, ya que la ruta incluye su pid.
+ *
+ * @return 0 en caso de éxito, -1 si no hay cgroup configurado o la ruta no entra en path
+ */
+int player_cgroup_path(const player_limits_t *limits, int player_idx, char *path, size_t size);
+
+/**
+ * Crea el cgroup del jugador (en el master, antes de fork) y escribe sus límites: memory.max y cpu.max.
+ * Si un límite no se puede escribir (por ejemplo, el controlador no está habilitado en el cgroup padre),
+ * se avisa por stderr y el cgroup se elimina.
+ *
+ * @param limits Límites configurados
+ * @param path Ruta del cgroup (player_cgroup_path)
+ *
+ * @return 0 en caso de éxito, -1 en caso de error
+ */
+int player_cgroup_create(const player_limits_t *limits, const char *path);
+
+// Elimina el cgroup del jugador, ya vacío, al terminar el juego
+void player_cgroup_remove(const char *path);
+
+/**
+ * Aplica los límites al proceso actual (el jugador, antes de execl). Si alguno no se puede aplicar se
+ * avisa por stderr y se siguen aplicando los demás.
+ *
+ * @param limits Límites configurados
+ * @param cgroup_path Cgroup al que se mueve el proceso (NULL para no usar cgroup)
+ *
+ * @return 0 si se aplicaron todos, -1 si falló alguno
+ */
+int apply_player_limits(const player_limits_t *limits, const char *cgroup_path);
+
+/**
+ * Determina si un jugador terminó por exceder un límite. Un SIGKILL que envió el propio master al
+ * recolectarlo nunca se atribuye a un límite.
+ *
+ * @param limits Límites configurados
+ * @param cgroup_path Cgroup del jugador (NULL si no tiene)
+ * @param status Estado de terminación (waitpid)
+ * @param usage Consumo del jugador (wait4)
+ * @param master_signal Última señal que le envió el master (0 si ninguna)
+ *
+ * @return Descripción del límite excedido, o NULL si terminó por otro motivo
+ */
+const char *player_limit_violation(const player_limits_t *limits, const char *cgroup_path, int status, const struct rusage *usage, int master_signal);
+
+// Consumo de un proceso esperado con wait4 (o del propio master con getrusage)
+typedef struct
+{
+    char label[64];
+    pid_t pid;
+    bool collected;
+    struct rusage usage;
+} process_usage_t;
+
+/**
+ * Imprime el consumo de cada proceso (CPU de usuario y sistema, RSS máximo, fallos de página y cambios de
+ * contexto voluntarios/involuntarios), una fila para el propio master y el total.
+ *
+ * @param children Procesos esperados (los no recolectados se informan como tales)
+ * @param count Cantidad de procesos
+ */
+void print_usage_report(const process_usage_t children[], int count);
+
+#endif
@@ -1,4 +1,7 @@
 #include "shared_memory.h"
+#include "board_access.h"
+#include "free_bitmap.h"
+#include "reward_index.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <errno.h>
@@ -67,7 +70,7 @@ void unlink_shared_memory(const char* name) {
 // Funciones específicas para el estado del juego
 
 size_t calculate_game_state_size(unsigned short width, unsigned short height) {
-    return sizeof(game_state_t) + (width * height * sizeof(int));
+    return sizeof(game_state_t) + board_alloc_cells(width, height) * sizeof(int);
 }
 
 game_state_t* create_game_state(unsigned short width, unsigned short height) {
@@ -94,19 +97,17 @@ game_state_t* create_game_state(unsigned short width, unsigned short height) {
     // Inicializar jugadores
     for (int i = 0; i < MAX_PLAYERS; i++) {
         memset(state->players[i].player_name, 0, MAX_NAME_LENGTH);
-        state->players[i].score = 0;
-        state->players[i].invalid_moves = 0;
-        state->players[i].valid_moves = 0;
-        state->players[i].pos_x = 0;
-        state->players[i].pos_y = 0;
+        PLAYER_HOT(state, i)->score = 0;
+        PLAYER_HOT(state, i)->invalid_moves = 0;
+        PLAYER_HOT(state, i)->valid_moves = 0;
+        PLAYER_HOT(state, i)->pos_x = 0;
+        PLAYER_HOT(state, i)->pos_y = 0;
         state->players[i].pid = 0;
-        state->players[i].is_blocked = false;
+        PLAYER_HOT(state, i)->is_blocked = false;
     }
     
-    // Inicializar el tablero con recompensas aleatorias (1-9)
-    for (int i = 0; i < width * height; i++) {
-        state->board[i] = (rand() % 9) + 1;
-    }
+    // El tablero lo completa el master (initialize_game_state), acá sólo se marca el borde centinela si lo hay
+    board_init_border(state);
     
     close_shared_memory(fd);
     return state;
@@ -259,3 +260,154 @@ void close_game_sync(game_sync_t* sync) {
         unmap_shared_memory(sync, sizeof(game_sync_t));
     }
 }
+
+// Funciones específicas para las extensiones
+
+// Las secciones de tamaño variable empiezan alineadas a línea de caché
+static size_t align_cache_line(size_t offset) {
+    return (offset + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1);
+}
+
+size_t calculate_game_ext_size(unsigned short width, unsigned short height) {
+    return align_cache_line(align_cache_line(sizeof(game_ext_t)) + free_bitmap_size(width, height)) +
+           reward_index_size(width, height);
+}
+
+static int init_robust_mutex(pthread_mutex_t *mutex) {
+    pthread_mutexattr_t attr;
+    int err = pthread_mutexattr_init(&attr);
+    if (err == 0)
+        err = pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    if (err == 0)
+        err = pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    if (err == 0)
+        err = pthread_mutex_init(mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    if (err != 0) {
+        fprintf(stderr, "pthread_mutex_init (robusto): %s\n", strerror(err));
+        return -1;
+    }
+    return 0;
+}
+
+int init_robust_lock(robust_rwlock_t* lock) {
+    if (init_robust_mutex(&lock->gate) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < LOCK_SLOTS; i++) {
+        if (init_robust_mutex(&lock->slot_owner[i]) != 0 || init_robust_mutex(&lock->slot_read[i]) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+game_ext_t* create_game_ext(unsigned short width, unsigned short height, unsigned int lock_mode) {
+    size_t size = calculate_game_ext_size(width, height);
+
+    int fd = create_shared_memory(GAME_EXT_NAME, size);
+    if (fd == -1) {
+        return NULL;
+    }
+
+    game_ext_t* ext = (game_ext_t*)map_shared_memory(fd, size, false);
+    close_shared_memory(fd);
+    if (ext == NULL) {
+        unlink_shared_memory(GAME_EXT_NAME);
+        return NULL;
+    }
+
+    // Un segmento que quedó de una partida anterior conserva su contenido: el registro de cambios y el
+    // anillo de eventos tienen que empezar vacíos
+    memset(ext, 0, size);
+    ext->size = size;
+    ext->lock_mode = lock_mode;
+    ext->board_width = width;
+    ext->board_height = height;
+    ext->free_row_words = (unsigned int)FREE_BITMAP_ROW_WORDS(width);
+    ext->free_bitmap_offset = align_cache_line(sizeof(game_ext_t));
+    ext->reward_index_offset = align_cache_line(ext->free_bitmap_offset + free_bitmap_size(width, height));
+
+    if (init_robust_lock(&ext->robust_lock) != 0) {
+        unmap_shared_memory(ext, size);
+        unlink_shared_memory(GAME_EXT_NAME);
+        return NULL;
+    }
+
+    return ext;
+}
+
+game_ext_t* open_game_ext(void) {
+    int fd = shm_open(GAME_EXT_NAME, O_RDWR, 0666);
+    if (fd == -1) {
+        if (errno != ENOENT) {
+            perror("shm_open game_ext");
+        }
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(game_ext_t)) {
+        close_shared_memory(fd);
+        return NULL;
+    }
+
+    game_ext_t* ext = (game_ext_t*)map_shared_memory(fd, st.st_size, false);
+    close_shared_memory(fd);
+    return ext;
+}
+
+void close_game_ext(game_ext_t* ext) {
+    if (ext != NULL) {
+        unmap_shared_memory(ext, ext->size);
+    }
+}
+
+int attach_game(game_state_t** state, size_t* state_size, game_sync_t** sync, game_ext_t** ext) {
+    *state = NULL;
+    *sync = NULL;
+    *ext = NULL;
+
+    int fd = open_shared_memory(GAME_SYNC_NAME, sizeof(game_sync_t), O_RDWR);
+    if (fd == -1) {
+        fprintf(stderr, "Error: no hay una partida en curso\n");
+        return -1;
+    }
+    *sync = map_shared_memory(fd, sizeof(game_sync_t), false);
+    close_shared_memory(fd);
+    if (*sync == NULL) {
+        return -1;
+    }
+
+    *ext = open_game_ext();
+    if (*ext == NULL) {
+        fprintf(stderr, "Error: el master no publica /game_ext (anillo de eventos)\n");
+        return -1;
+    }
+
+    fd = open_shared_memory(GAME_STATE_NAME, 0, O_RDONLY);
+    if (fd == -1) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        perror("fstat");
+        close_shared_memory(fd);
+        return -1;
+    }
+    *state_size = st.st_size;
+    *state = map_shared_memory(fd, *state_size, true);
+    close_shared_memory(fd);
+    return *state == NULL ? -1 : 0;
+}
+
+void detach_game(game_state_t** state, size_t state_size, game_sync_t** sync, game_ext_t** ext) {
+    if (*state != NULL) {
+        unmap_shared_memory(*state, state_size);
+    }
+    close_game_sync(*sync);
+    close_game_ext(*ext);
+    *state = NULL;
+    *sync = NULL;
+    *ext = NULL;
+}
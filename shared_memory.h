@@ -8,14 +8,22 @@
 #include <semaphore.h>
 #include <stdbool.h>
 #include <sys/types.h>
+#include <pthread.h>
+#include "change_log.h"
+#include "event_ring.h"
 
 #define GAME_STATE_NAME "/game_state"
 #define GAME_SYNC_NAME "/game_sync"
+#define GAME_EXT_NAME "/game_ext"
 #define MAX_NAME_LENGTH 16
 #define MAX_PLAYERS 9
+#define LOCK_SLOTS 16 // Procesos lectores simultáneos del lock robusto (jugadores, vista y observadores)
 
 
+#define CACHE_LINE_SIZE 64
+
 /* Las siguientes estructuras son almacenadas en una memoria compartida cuyo nombre es “/game_state” */
+#ifndef SPLIT_PLAYER_LAYOUT
 typedef struct
 {
     char player_name[MAX_NAME_LENGTH]; // Nombre del jugador
@@ -27,6 +35,29 @@ typedef struct
     bool is_blocked;                   // Indica si el jugador está bloqueado
 } player_t;
 
+// En el formato de la especificación los campos calientes están dentro de player_t
+typedef player_t player_hot_t;
+#else
+/* Formato alternativo (make SPLIT_PLAYERS=1): los campos que el master escribe en cada movimiento van en
+ * una línea de caché propia por jugador, separados de los datos que no cambian durante el juego. Así la
+ * escritura del puntaje de un jugador no invalida la línea que la vista u otro jugador están leyendo.
+ * Incompatible con binarios compilados con el formato de la especificación */
+typedef struct
+{
+    unsigned int score;          // Puntaje
+    unsigned int invalid_moves;  // Cantidad de solicitudes de movimientos inválidas realizadas
+    unsigned int valid_moves;    // Cantidad de solicitudes de movimientos válidas realizadas
+    unsigned short pos_x, pos_y; // Coordenadas x e y en el tablero
+    bool is_blocked;             // Indica si el jugador está bloqueado
+} __attribute__((aligned(CACHE_LINE_SIZE))) player_hot_t;
+
+typedef struct
+{
+    char player_name[MAX_NAME_LENGTH]; // Nombre del jugador
+    pid_t pid;                         // Identificador de proceso
+} player_t;
+#endif
+
 typedef struct
 {
     unsigned short board_width;    // Ancho del tablero
@@ -34,9 +65,19 @@ typedef struct
     unsigned int player_count;     // Cantidad de jugadores
     player_t players[MAX_PLAYERS]; // Lista de jugadores
     bool game_over;                // Indica si el juego se ha terminado
+#ifdef SPLIT_PLAYER_LAYOUT
+    player_hot_t players_hot[MAX_PLAYERS]; // Campos calientes de cada jugador, una línea de caché cada uno
+#endif
     int board[];                   // Puntero al comienzo del tablero. fila-0, fila-1, ..., fila-n-1
 } game_state_t;
 
+// Acceso a los campos calientes (score, movimientos, posición, bloqueo) independiente del formato
+#ifdef SPLIT_PLAYER_LAYOUT
+#define PLAYER_HOT(state, i) (&(state)->players_hot[(i)])
+#else
+#define PLAYER_HOT(state, i) (&(state)->players[(i)])
+#endif
+
 /* La siguiente estructura se almacena en una memoria compartida cuyo nombre es “/game_sync”*/
 typedef struct
 {
@@ -52,6 +93,39 @@ typedef struct
     sem_t player_move_sem[MAX_PLAYERS]; // Le indican a cada jugador que puede enviar 1 movimiento
 } game_sync_t;
 
+/* Lock lectores-escritores robusto: todos sus mutex son PTHREAD_MUTEX_ROBUST y compartidos entre procesos,
+ * así que si un proceso muere dentro de la sección crítica el siguiente en tomar el mutex recibe EOWNERDEAD
+ * y lo recupera, en lugar de quedar bloqueado para siempre */
+typedef struct
+{
+    pthread_mutex_t gate;                   // Equivalente a master_access_mutex: evita inanición del escritor
+    pthread_mutex_t slot_owner[LOCK_SLOTS]; // Cada proceso lector retiene uno mientras vive
+    pthread_mutex_t slot_read[LOCK_SLOTS];  // El lector retiene el suyo mientras lee; el escritor los toma todos
+} robust_rwlock_t;
+
+#define LOCK_MODE_SEM 0    // Protocolo de semáforos de /game_sync
+#define LOCK_MODE_ROBUST 1 // robust_rwlock_t de /game_ext
+
+/* Extensiones propias almacenadas en la memoria compartida “/game_ext”. Es opcional: /game_state y /game_sync
+ * mantienen exactamente el formato de la especificación, y los procesos que no encuentran /game_ext
+ * siguen funcionando sólo con ellas */
+typedef struct
+{
+    size_t size;                 // Tamaño total del segmento
+    unsigned int lock_mode;      // LOCK_MODE_SEM o LOCK_MODE_ROBUST
+    robust_rwlock_t robust_lock; // Lock usado por reader_enter/writer_enter en modo LOCK_MODE_ROBUST
+    change_log_t change_log;     // Cambios del tablero, para mantener copias locales (player_sdk.h)
+    event_ring_t events;         // Eventos del juego para cualquier cantidad de observadores (event_ring.h)
+    uint64_t board_hash;         // Hash Zobrist del tablero y las posiciones (zobrist.h)
+
+    // Índices del tablero mantenidos por el master; sus datos siguen a esta estructura en el segmento
+    unsigned short board_width, board_height;
+    unsigned long free_cells;    // Celdas libres restantes
+    unsigned int free_row_words; // Palabras de 64 bits por fila del bitmap de celdas libres
+    size_t free_bitmap_offset;   // Desplazamiento del bitmap desde el inicio del segmento (free_bitmap.h)
+    size_t reward_index_offset;  // Desplazamiento del árbol de Fenwick de recompensas (reward_index.h)
+} game_ext_t;
+
 
 // Funciones para crear y abrir memoria compartida
 int create_shared_memory(const char *name, size_t size);
@@ -70,7 +144,24 @@ game_sync_t* create_game_sync(unsigned int player_count);
 game_sync_t* open_game_sync(void);
 void close_game_sync(game_sync_t* sync);
 
+game_ext_t* create_game_ext(unsigned short width, unsigned short height, unsigned int lock_mode);
+game_ext_t* open_game_ext(void); // NULL sin mensajes de error si el master no creó /game_ext
+void close_game_ext(game_ext_t* ext);
+int init_robust_lock(robust_rwlock_t* lock); // Inicializa un robust_rwlock_t ubicado en memoria compartida
+
+/**
+ * Se adjunta a la partida en curso desde un proceso que no lanzó el master (observer, render): mapea
+ * /game_sync, /game_ext (obligatorio, por el anillo de eventos) y /game_state en solo lectura, con el
+ * tamaño real del segmento. Informa por stderr lo que falte. El lock robusto lo elige quien llama.
+ *
+ * @return 0 en caso de éxito, -1 en caso de error (lo ya mapeado queda en los punteros, para detach_game)
+ */
+int attach_game(game_state_t** state, size_t* state_size, game_sync_t** sync, game_ext_t** ext);
+// Desmapea lo que attach_game haya mapeado y deja los punteros en NULL
+void detach_game(game_state_t** state, size_t state_size, game_sync_t** sync, game_ext_t** ext);
+
 // Funciones de utilidad para calcular tamaños
 size_t calculate_game_state_size(unsigned short width, unsigned short height);
+size_t calculate_game_ext_size(unsigned short width, unsigned short height);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "spectator_replica.h"
+#include "clock_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/*
+ * Cliente del socket de espectadores (master -S ruta). No necesita memoria compartida: reconstruye el
+ * tablero a partir del keyframe y los deltas que envía el servidor (spectator_proto.h).
+ *
+ * Uso: spectator -S ruta [-o archivo] [-i intervalo_ms] [-d demora_ms]
+ *   -o  guarda los frames tal como llegan, para reproducirlos después
+ *   -i  cada intervalo imprime frames y bytes recibidos
+ *   -d  demora después de cada frame, para simular un cliente lento
+ *
+ * Al terminar la partida imprime el puntaje final de cada jugador.
+ */
+
+#define DEFAULT_REPORT_MS 1000
+
+typedef struct
+{
+    unsigned long frames;
+    unsigned long keyframes;
+    unsigned long deltas;
+    unsigned long long bytes;
+    uint64_t seq;
+} spectator_stats_t;
+
+volatile sig_atomic_t stop_requested = 0;
+
+static spectator_replica_t replica;
+
+static void signal_handler(int sig)
+{
+    (void)sig;
+    stop_requested = 1;
+}
+
+static int connect_server(const char *path)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "Error: ruta de socket demasiado larga: '%s'\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1)
+    {
+        perror("socket");
+        return -1;
+    }
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == -1)
+    {
+        perror("connect");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void print_summary(const spectator_stats_t *stats, bool ended)
+{
+    fprintf(stderr, "spectator: %lu frames (%lu keyframes, %lu deltas), %llu bytes, seq %llu%s\n", stats->frames,
+            stats->keyframes, stats->deltas, stats->bytes, (unsigned long long)stats->seq,
+            ended ? "" : " [sin fin de partida]");
+    unsigned long owned[SPECTATOR_MAX_PLAYERS] = {0};
+    const int8_t *board = replica.cells;
+    for (size_t i = 0; board != NULL && i < (size_t)replica.width * replica.height; ++i)
+        if (board[i] <= 0 && -board[i] < (int)replica.player_count)
+            owned[-board[i]]++;
+    for (unsigned int i = 0; i < replica.player_count; ++i)
+    {
+        const spectator_player_t *p = &replica.players[i];
+        fprintf(stderr, "  player %s %u: score %u, %u valid / %u invalid moves, %lu cells%s\n", p->name, i, p->score,
+                p->valid_moves, p->invalid_moves, owned[i], p->blocked ? " [BLOCKED]" : "");
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const char *socket_path = NULL;
+    const char *record_path = NULL;
+    unsigned int report_ms = DEFAULT_REPORT_MS;
+    unsigned int delay_ms = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "S:o:i:d:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'S':
+            socket_path = optarg;
+            break;
+        case 'o':
+            record_path = optarg;
+            break;
+        case 'i':
+            report_ms = (unsigned int)atoi(optarg);
+            if (report_ms == 0)
+            {
+                fprintf(stderr, "Error: intervalo inválido '%s'\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'd':
+            delay_ms = (unsigned int)atoi(optarg);
+            break;
+        default:
+            socket_path = NULL;
+            break;
+        }
+    }
+    if (socket_path == NULL)
+    {
+        fprintf(stderr, "Uso: %s -S ruta [-o archivo] [-i intervalo_ms] [-d demora_ms]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    struct sigaction sa;
+    sa.sa_handler = signal_handler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = 0;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    int fd = connect_server(socket_path);
+    if (fd == -1)
+        return EXIT_FAILURE;
+    FILE *record = NULL;
+    if (record_path != NULL && (record = fopen(record_path, "wb")) == NULL)
+    {
+        perror("fopen");
+        close(fd);
+        return EXIT_FAILURE;
+    }
+
+    spectator_stats_t stats = {0};
+    char *body = NULL;
+    size_t body_cap = 0;
+    bool ended = false;
+    int status = EXIT_SUCCESS;
+    uint64_t last_report = monotonic_ms();
+    unsigned long frames_at_report = 0;
+    while (!ended && !stop_requested)
+    {
+        spectator_frame_t frame;
+        int r = spectator_frame_read(fd, &frame, &body, &body_cap);
+        if (r != 0)
+        {
+            if (r == -1 && !stop_requested)
+            {
+                fprintf(stderr, "Error: frame inválido o conexión cortada\n");
+                status = EXIT_FAILURE;
+            }
+            break;
+        }
+
+        size_t body_size = frame.size - sizeof(frame);
+        if (record != NULL)
+        {
+            fwrite(&frame, sizeof(frame), 1, record);
+            fwrite(body, 1, body_size, record);
+        }
+        stats.frames++;
+        stats.bytes += frame.size;
+        stats.seq = frame.seq;
+        stats.keyframes += frame.type == SPECTATOR_KEYFRAME;
+        stats.deltas += frame.type == SPECTATOR_DELTA;
+        ended = frame.type == SPECTATOR_END;
+        if (spectator_replica_apply(&replica, &frame, body, body_size) != 0)
+        {
+            fprintf(stderr, "Error: frame %lu (tipo %u) mal formado\n", stats.frames, frame.type);
+            status = EXIT_FAILURE;
+            break;
+        }
+
+        uint64_t now = monotonic_ms();
+        if (now - last_report >= report_ms)
+        {
+            printf("frames %lu (+%lu) keyframes %lu bytes %llu seq %llu\n", stats.frames,
+                   stats.frames - frames_at_report, stats.keyframes, stats.bytes, (unsigned long long)stats.seq);
+            fflush(stdout);
+            last_report = now;
+            frames_at_report = stats.frames;
+        }
+        if (delay_ms > 0)
+            usleep(delay_ms * 1000);
+    }
+
+    print_summary(&stats, ended);
+    if (record != NULL)
+        fclose(record);
+    free(body);
+    spectator_replica_free(&replica);
+    close(fd);
+    return status;
+}
@@ -0,0 +1,67 @@
+#ifndef SPECTATOR_PROTO_H
+#define SPECTATOR_PROTO_H
+
+#include <stdint.h>
+
+/*
+ * Protocolo del socket de espectadores (master -S ruta). Cada frame empieza con spectator_frame_t; los
+ * enteros van en el orden de bytes del host, ya que cliente y servidor corren en la misma máquina.
+ *
+ * - SPECTATOR_KEYFRAME: spectator_keyframe_t, player_count spectator_player_t y luego width * height
+ *   celdas de un byte con signo (recompensa 1..9 o -jugador), fila por fila. Es lo primero que recibe
+ *   cada cliente, y lo que recibe otra vez si se atrasa.
+ * - SPECTATOR_DELTA: spectator_delta_t, cell_count spectator_cell_t y player_count spectator_player_t
+ *   (sólo los jugadores que cambiaron).
+ * - SPECTATOR_END: la partida terminó; no hay cuerpo y el servidor cierra la conexión.
+ *
+ * seq es la cantidad de eventos del anillo de /game_ext incluidos en el frame: un delta con seq s se
+ * aplica sobre el frame anterior, cuya seq es la que el cliente ya tiene.
+ */
+
+#define SPECTATOR_KEYFRAME 1
+#define SPECTATOR_DELTA 2
+#define SPECTATOR_END 3
+
+#define SPECTATOR_MAX_PLAYERS 9 // Igual que MAX_PLAYERS de shared_memory.h
+
+typedef struct
+{
+    uint32_t size; // Bytes del frame, incluido este encabezado
+    uint8_t type;
+    uint8_t reserved[3];
+    uint64_t seq;
+} spectator_frame_t;
+
+typedef struct
+{
+    char name[16];
+    uint16_t x, y;
+    uint32_t score;
+    uint32_t valid_moves;
+    uint32_t invalid_moves;
+    uint8_t index;
+    uint8_t blocked;
+    uint8_t reserved[2];
+} spectator_player_t;
+
+typedef struct
+{
+    uint16_t width, height;
+    uint8_t player_count;
+    uint8_t reserved[3];
+} spectator_keyframe_t;
+
+typedef struct
+{
+    uint32_t cell_count;
+    uint8_t player_count;
+    uint8_t reserved[3];
+} spectator_delta_t;
+
+typedef struct
+{
+    uint32_t cell; // y * width + x
+    int32_t value;
+} spectator_cell_t;
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef SPECTATOR_REPLICA_H
+#define SPECTATOR_REPLICA_H
+
+#include "spectator_proto.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+/*
+ * Copia del juego armada a partir de frames del socket de espectadores o de una grabación
+ * (spectator -o). La usan el cliente espectador y el exportador de frames.
+ */
+
+typedef struct
+{
+    uint16_t width, height;
+    unsigned int player_count;
+    int8_t *cells; // width * height, fila por fila (NULL hasta el primer keyframe)
+    spectator_player_t players[SPECTATOR_MAX_PLAYERS];
+    uint64_t seq;
+} spectator_replica_t;
+
+static inline void spectator_replica_free(spectator_replica_t *replica)
+{
+    free(replica->cells);
+    replica->cells = NULL;
+}
+
+static inline int spectator_replica_keyframe(spectator_replica_t *replica, const char *body, size_t size)
+{
+    spectator_keyframe_t header;
+    if (size < sizeof(header))
+        return -1;
+    memcpy(&header, body, sizeof(header));
+    size_t cells = (size_t)header.width * header.height;
+    if (header.player_count > SPECTATOR_MAX_PLAYERS ||
+        size != sizeof(header) + header.player_count * sizeof(spectator_player_t) + cells)
+        return -1;
+
+    if (replica->cells == NULL || header.width != replica->width || header.height != replica->height)
+    {
+        int8_t *resized = realloc(replica->cells, cells);
+        if (resized == NULL)
+        {
+            perror("realloc (tablero)");
+            return -1;
+        }
+        replica->cells = resized;
+        replica->width = header.width;
+        replica->height = header.height;
+    }
+    replica->player_count = header.player_count;
+    body += sizeof(header);
+    memcpy(replica->players, body, replica->player_count * sizeof(spectator_player_t));
+    memcpy(replica->cells, body + replica->player_count * sizeof(spectator_player_t), cells);
+    return 0;
+}
+
+static inline int spectator_replica_delta(spectator_replica_t *replica, const char *body, size_t size)
+{
+    spectator_delta_t header;
+    if (replica->cells == NULL || size < sizeof(header))
+        return -1;
+    memcpy(&header, body, sizeof(header));
+    if (size != sizeof(header) + (size_t)header.cell_count * sizeof(spectator_cell_t) +
+                    header.player_count * sizeof(spectator_player_t))
+        return -1;
+
+    size_t cells = (size_t)replica->width * replica->height;
+    body += sizeof(header);
+    for (uint32_t i = 0; i < header.cell_count; ++i)
+    {
+        spectator_cell_t cell;
+        memcpy(&cell, body, sizeof(cell));
+        body += sizeof(cell);
+        if (cell.cell < cells)
+            replica->cells[cell.cell] = (int8_t)cell.value;
+    }
+    for (unsigned int i = 0; i < header.player_count; ++i)
+    {
+        spectator_player_t player;
+        memcpy(&player, body, sizeof(player));
+        body += sizeof(player);
+        if (player.index < replica->player_count)
+            replica->players[player.index] = player;
+    }
+    return 0;
+}
+
+/**
+ * Aplica un frame a la copia. SPECTATOR_END y los tipos desconocidos no la modifican.
+ *
+ * @return 0 en caso de éxito, -1 si el frame está mal formado
+ */
+static inline int spectator_replica_apply(spectator_replica_t *replica, const spectator_frame_t *frame,
+                                          const char *body, size_t size)
+{
+    int result = 0;
+    if (frame->type == SPECTATOR_KEYFRAME)
+        result = spectator_replica_keyframe(replica, body, size);
+    else if (frame->type == SPECTATOR_DELTA)
+        result = spectator_replica_delta(replica, body, size);
+    if (result == 0)
+        replica->seq = frame->seq;
+    return result;
+}
+
+/**
+ * Lee un frame completo de un socket o de una grabación. El cuerpo queda en *body, que se agranda según
+ * haga falta. Una señal interrumpe la lectura (retorna -1 con errno EINTR).
+ *
+ * @return 0 si leyó un frame, 1 al llegar al final sin datos pendientes, -1 en caso de error o frame
+ *         truncado
+ */
+static inline int spectator_frame_read(int fd, spectator_frame_t *frame, char **body, size_t *body_cap)
+{
+    size_t done = 0;
+    while (done < sizeof(*frame))
+    {
+        ssize_t n = read(fd, (char *)frame + done, sizeof(*frame) - done);
+        if (n <= 0)
+            return n == 0 && done == 0 ? 1 : -1;
+        done += (size_t)n;
+    }
+    if (frame->size < sizeof(*frame))
+    {
+        errno = EPROTO;
+        return -1;
+    }
+
+    size_t size = frame->size - sizeof(*frame);
+    if (size > *body_cap)
+    {
+        char *grown = realloc(*body, size);
+        if (grown == NULL)
+            return -1;
+        *body = grown;
+        *body_cap = size;
+    }
+    for (done = 0; done < size;)
+    {
+        ssize_t n = read(fd, *body + done, size - done);
+        if (n <= 0)
+            return -1;
+        done += (size_t)n;
+    }
+    return 0;
+}
+
+#endif
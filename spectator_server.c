@@ -0,0 +1,414 @@
+#include "spectator_server.h"
+#include "sync_utils.h"
+#include "board_access.h"
+#include "event_ring.h"
+#include "clock_utils.h"
+#include "unix_socket.h"
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+typedef struct {
+    int fd;
+    char *buf;           // Frames completos pendientes de enviar
+    size_t len, sent, cap;
+    bool needs_keyframe; // Recién conectado, o se descartaron deltas por lento
+    bool ended;          // Ya tiene el SPECTATOR_END en el buffer
+} spectator_client_t;
+
+typedef struct {
+    const game_state_t *state;
+    game_sync_t *sync;
+    game_ext_t *ext;
+    unsigned short width, height;
+    unsigned int player_count;
+    int8_t *board;       // Copia del tablero, una celda por byte
+    spectator_player_t players[MAX_PLAYERS];
+    uint64_t cursor;     // Próximo evento del anillo
+    uint8_t *dirty_mark; // 1 si la celda ya está en dirty_cells
+    uint32_t *dirty_cells;
+    size_t dirty_count;
+    unsigned int dirty_players; // Máscara de jugadores que cambiaron
+    bool game_over;
+    char *frame;         // Espacio para armar un frame (alcanza para un keyframe o un delta)
+    size_t keyframe_size;
+    spectator_client_t clients[SPECTATOR_MAX_CLIENTS];
+    int client_count;
+} spectator_server_t;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void stop_handler(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+
+static void mark_cell(spectator_server_t *srv, uint32_t cell) {
+    if (!srv->dirty_mark[cell]) {
+        srv->dirty_mark[cell] = 1;
+        srv->dirty_cells[srv->dirty_count++] = cell;
+    }
+}
+
+static void clear_dirty(spectator_server_t *srv) {
+    for (size_t i = 0; i < srv->dirty_count; ++i) {
+        srv->dirty_mark[srv->dirty_cells[i]] = 0;
+    }
+    srv->dirty_count = 0;
+    srv->dirty_players = 0;
+}
+
+void spectator_player_from_state(spectator_player_t *p, const game_state_t *state, unsigned int i) {
+    const player_hot_t *hot = PLAYER_HOT(state, i);
+    memset(p, 0, sizeof(*p));
+    strncpy(p->name, state->players[i].player_name, sizeof(p->name) - 1);
+    p->x = hot->pos_x;
+    p->y = hot->pos_y;
+    p->score = hot->score;
+    p->valid_moves = hot->valid_moves;
+    p->invalid_moves = hot->invalid_moves;
+    p->index = (uint8_t)i;
+    p->blocked = hot->is_blocked;
+}
+
+// Copia el estado bajo el lock de lectura; los clientes conectados necesitan un keyframe nuevo
+static void take_snapshot(spectator_server_t *srv) {
+    const game_state_t *state = srv->state;
+    reader_enter(srv->sync);
+    for (unsigned short y = 0; y < srv->height; ++y) {
+        for (unsigned short x = 0; x < srv->width; ++x) {
+            srv->board[(size_t)y * srv->width + x] = (int8_t)BOARD_CELL(state, x, y);
+        }
+    }
+    for (unsigned int i = 0; i < srv->player_count; ++i) {
+        spectator_player_from_state(&srv->players[i], state, i);
+    }
+    srv->cursor = event_ring_head(&srv->ext->events);
+    srv->game_over = state->game_over;
+    reader_exit(srv->sync);
+
+    clear_dirty(srv);
+    for (int c = 0; c < srv->client_count; ++c) {
+        srv->clients[c].needs_keyframe = true;
+    }
+}
+
+static void apply_event(spectator_server_t *srv, const game_event_t *event) {
+    if (event->kind == EVENT_GAME_OVER) {
+        srv->game_over = true;
+        return;
+    }
+    if (event->player >= srv->player_count) {
+        return;
+    }
+    spectator_player_t *p = &srv->players[event->player];
+    switch (event->kind) {
+    case EVENT_MOVE:
+        srv->board[event->to] = (int8_t)-(int)event->player;
+        mark_cell(srv, event->to);
+        p->x = (uint16_t)(event->to % srv->width);
+        p->y = (uint16_t)(event->to / srv->width);
+        p->score += (uint32_t)event->score_delta;
+        p->valid_moves++;
+        break;
+    case EVENT_INVALID:
+        p->invalid_moves++;
+        break;
+    case EVENT_BLOCKED:
+        p->blocked = 1;
+        break;
+    default:
+        return;
+    }
+    srv->dirty_players |= 1u << event->player;
+}
+
+static void drain_events(spectator_server_t *srv) {
+    game_event_t event;
+    for (;;) {
+        event_ring_status_t status = event_ring_read(&srv->ext->events, srv->cursor, &event);
+        if (status == EVENT_RING_EMPTY) {
+            return;
+        }
+        if (status == EVENT_RING_LAGGED) {
+            take_snapshot(srv);
+            continue;
+        }
+        apply_event(srv, &event);
+        srv->cursor++;
+    }
+}
+
+static size_t build_keyframe(spectator_server_t *srv) {
+    char *p = srv->frame;
+    spectator_frame_t header = {(uint32_t)srv->keyframe_size, SPECTATOR_KEYFRAME, {0}, srv->cursor};
+    spectator_keyframe_t body = {srv->width, srv->height, (uint8_t)srv->player_count, {0}};
+    memcpy(p, &header, sizeof(header));
+    p += sizeof(header);
+    memcpy(p, &body, sizeof(body));
+    p += sizeof(body);
+    memcpy(p, srv->players, srv->player_count * sizeof(spectator_player_t));
+    p += srv->player_count * sizeof(spectator_player_t);
+    memcpy(p, srv->board, (size_t)srv->width * srv->height);
+    return srv->keyframe_size;
+}
+
+static size_t build_delta(spectator_server_t *srv) {
+    char *p = srv->frame + sizeof(spectator_frame_t) + sizeof(spectator_delta_t);
+    for (size_t i = 0; i < srv->dirty_count; ++i) {
+        spectator_cell_t cell = {srv->dirty_cells[i], srv->board[srv->dirty_cells[i]]};
+        memcpy(p, &cell, sizeof(cell));
+        p += sizeof(cell);
+    }
+    uint8_t players = 0;
+    for (unsigned int i = 0; i < srv->player_count; ++i) {
+        if (srv->dirty_players & (1u << i)) {
+            memcpy(p, &srv->players[i], sizeof(spectator_player_t));
+            p += sizeof(spectator_player_t);
+            players++;
+        }
+    }
+
+    size_t size = (size_t)(p - srv->frame);
+    spectator_frame_t header = {(uint32_t)size, SPECTATOR_DELTA, {0}, srv->cursor};
+    spectator_delta_t body = {(uint32_t)srv->dirty_count, players, {0}};
+    memcpy(srv->frame, &header, sizeof(header));
+    memcpy(srv->frame + sizeof(header), &body, sizeof(body));
+    return size;
+}
+
+// Agrega un frame completo al buffer del cliente. Retorna false si no entra.
+static bool enqueue(spectator_client_t *client, const void *data, size_t size) {
+    if (client->len + size > client->cap && client->sent > 0) {
+        memmove(client->buf, client->buf + client->sent, client->len - client->sent);
+        client->len -= client->sent;
+        client->sent = 0;
+    }
+    if (client->len + size > client->cap) {
+        return false;
+    }
+    memcpy(client->buf + client->len, data, size);
+    client->len += size;
+    return true;
+}
+
+static void close_client(spectator_server_t *srv, int c) {
+    close(srv->clients[c].fd);
+    free(srv->clients[c].buf);
+    srv->clients[c] = srv->clients[--srv->client_count];
+}
+
+static void accept_clients(spectator_server_t *srv, int listen_fd) {
+    for (;;) {
+        int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd == -1) {
+            return;
+        }
+        if (srv->client_count == SPECTATOR_MAX_CLIENTS || srv->game_over) {
+            close(fd);
+            continue;
+        }
+        spectator_client_t *client = &srv->clients[srv->client_count];
+        memset(client, 0, sizeof(*client));
+        client->cap = SPECTATOR_CLIENT_BUFFER > srv->keyframe_size ? SPECTATOR_CLIENT_BUFFER : srv->keyframe_size;
+        client->buf = malloc(client->cap);
+        if (client->buf == NULL) {
+            close(fd);
+            continue;
+        }
+        client->fd = fd;
+        client->needs_keyframe = true;
+        srv->client_count++;
+    }
+}
+
+static void server_tick(spectator_server_t *srv) {
+    drain_events(srv);
+
+    if (srv->dirty_count > 0 || srv->dirty_players != 0) {
+        // Si el delta pesaría más que el tablero completo, conviene un keyframe para todos
+        if (srv->dirty_count * sizeof(spectator_cell_t) >= (size_t)srv->width * srv->height) {
+            for (int c = 0; c < srv->client_count; ++c) {
+                srv->clients[c].needs_keyframe = true;
+            }
+        } else {
+            size_t size = build_delta(srv);
+            for (int c = 0; c < srv->client_count; ++c) {
+                spectator_client_t *client = &srv->clients[c];
+                if (!client->needs_keyframe && !client->ended && !enqueue(client, srv->frame, size)) {
+                    client->needs_keyframe = true; // Lento: se descartan deltas hasta que vacíe el buffer
+                }
+            }
+        }
+        clear_dirty(srv);
+    }
+
+    // Keyframes sólo sobre buffers vacíos, así nunca quedan detrás de deltas viejos
+    bool keyframe_built = false;
+    for (int c = 0; c < srv->client_count; ++c) {
+        spectator_client_t *client = &srv->clients[c];
+        if (client->needs_keyframe && !client->ended && client->len == client->sent) {
+            size_t size = keyframe_built ? srv->keyframe_size : build_keyframe(srv);
+            keyframe_built = true;
+            client->len = client->sent = 0;
+            if (enqueue(client, srv->frame, size)) {
+                client->needs_keyframe = false;
+            }
+        }
+        if (srv->game_over && !client->needs_keyframe && !client->ended) {
+            spectator_frame_t end = {sizeof(spectator_frame_t), SPECTATOR_END, {0}, srv->cursor};
+            client->ended = enqueue(client, &end, sizeof(end));
+        }
+    }
+}
+
+// Envía lo que se pueda sin bloquear. Retorna -1 si el cliente se desconectó.
+static int flush_client(spectator_client_t *client) {
+    while (client->sent < client->len) {
+        ssize_t n = send(client->fd, client->buf + client->sent, client->len - client->sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n > 0) {
+            client->sent += (size_t)n;
+        } else if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return 0;
+        } else if (n == -1 && errno == EINTR) {
+            continue;
+        } else {
+            return -1;
+        }
+    }
+    client->len = client->sent = 0;
+    return 0;
+}
+
+static void serve(spectator_server_t *srv, int listen_fd, pid_t master_pid) {
+    struct pollfd fds[SPECTATOR_MAX_CLIENTS + 1];
+    uint64_t next_tick = monotonic_ms();
+    uint64_t finish_deadline = 0;
+
+    while (!stop_requested) {
+        uint64_t now = monotonic_ms();
+        if (now >= next_tick) {
+            if (getppid() != master_pid) {
+                break; // El master murió sin terminar la partida
+            }
+            server_tick(srv);
+            next_tick = now + SPECTATOR_TICK_MS;
+        }
+
+        if (srv->game_over) {
+            if (finish_deadline == 0) {
+                finish_deadline = now + SPECTATOR_FINISH_MS;
+            }
+            for (int c = srv->client_count - 1; c >= 0; --c) {
+                if (srv->clients[c].ended && srv->clients[c].len == srv->clients[c].sent) {
+                    close_client(srv, c);
+                }
+            }
+            if (srv->client_count == 0 || now >= finish_deadline) {
+                break;
+            }
+        }
+
+        fds[0].fd = listen_fd;
+        fds[0].events = POLLIN;
+        for (int c = 0; c < srv->client_count; ++c) {
+            fds[c + 1].fd = srv->clients[c].fd;
+            fds[c + 1].events = POLLIN | (srv->clients[c].len > srv->clients[c].sent ? POLLOUT : 0);
+        }
+        int count = srv->client_count;
+        int timeout = next_tick > now ? (int)(next_tick - now) : 0;
+        if (poll(fds, (nfds_t)count + 1, timeout) <= 0) {
+            continue;
+        }
+
+        // De atrás hacia adelante: close_client mueve el último cliente al lugar del que se cierra
+        for (int c = count - 1; c >= 0; --c) {
+            short revents = fds[c + 1].revents;
+            bool gone = (revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+            if (!gone && (revents & POLLIN)) {
+                char discard[256]; // Los espectadores no envían nada; un 0 es una desconexión
+                ssize_t n = recv(srv->clients[c].fd, discard, sizeof(discard), MSG_DONTWAIT);
+                gone = n == 0 || (n == -1 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+            }
+            if (!gone && (revents & POLLOUT)) {
+                gone = flush_client(&srv->clients[c]) == -1;
+            }
+            if (gone) {
+                close_client(srv, c);
+            }
+        }
+        if (fds[0].revents & POLLIN) {
+            accept_clients(srv, listen_fd);
+        }
+    }
+}
+
+static int run_server(const char *path, int listen_fd, const game_state_t *state, game_sync_t *game_sync,
+                      game_ext_t *ext, pid_t master_pid) {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = stop_handler;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    static spectator_server_t srv;
+    srv.state = state;
+    srv.sync = game_sync;
+    srv.ext = ext;
+    srv.width = state->board_width;
+    srv.height = state->board_height;
+    srv.player_count = state->player_count < MAX_PLAYERS ? state->player_count : MAX_PLAYERS;
+
+    size_t cells = (size_t)srv.width * srv.height;
+    srv.keyframe_size = sizeof(spectator_frame_t) + sizeof(spectator_keyframe_t) +
+                        srv.player_count * sizeof(spectator_player_t) + cells;
+    srv.board = malloc(cells);
+    srv.dirty_mark = calloc(cells, 1);
+    srv.dirty_cells = malloc(cells * sizeof(uint32_t));
+    // Un delta se envía sólo si sus celdas pesan menos que el tablero, así que entra en este espacio
+    srv.frame = malloc(srv.keyframe_size + sizeof(spectator_delta_t) + sizeof(spectator_cell_t));
+    if (srv.board == NULL || srv.dirty_mark == NULL || srv.dirty_cells == NULL || srv.frame == NULL) {
+        perror("malloc (servidor de espectadores)");
+        return EXIT_FAILURE;
+    }
+
+    take_snapshot(&srv);
+    serve(&srv, listen_fd, master_pid);
+
+    while (srv.client_count > 0) {
+        close_client(&srv, srv.client_count - 1);
+    }
+    close(listen_fd);
+    unlink(path);
+    sync_release_robust_lock();
+    return EXIT_SUCCESS;
+}
+
+pid_t spectator_server_start(const char *path, const game_state_t *state, game_sync_t *game_sync, game_ext_t *ext) {
+    int listen_fd = unix_socket_listen(path, SPECTATOR_MAX_CLIENTS, false, "socket de espectadores");
+    if (listen_fd == -1) {
+        return -1;
+    }
+
+    pid_t master_pid = getpid();
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == -1) {
+        perror("fork (servidor de espectadores)");
+        close(listen_fd);
+        unlink(path);
+        return -1;
+    }
+    if (pid == 0) {
+        _exit(run_server(path, listen_fd, state, game_sync, ext, master_pid));
+    }
+    close(listen_fd);
+    return pid;
+}
@@ -0,0 +1,44 @@
+#ifndef SPECTATOR_SERVER_H
+#define SPECTATOR_SERVER_H
+
+#include "shared_memory.h"
+#include "spectator_proto.h"
+#include <sys/types.h>
+
+/*
+ * Servidor de espectadores en un socket Unix (master -S ruta). Corre en un proceso hijo del master que
+ * sigue el anillo de eventos de /game_ext, así que el master nunca lo espera. Los espectadores no mapean
+ * memoria compartida ni tocan semáforos: reciben un keyframe con el tablero completo y después, cada
+ * SPECTATOR_TICK_MS, un delta con las celdas y los jugadores que cambiaron (spectator_proto.h).
+ *
+ * Cada cliente tiene un buffer acotado. Si un delta no entra porque el cliente lee lento, se descartan los
+ * deltas siguientes hasta que el buffer se vacíe, y entonces recibe un keyframe nuevo.
+ */
+
+#define SPECTATOR_MAX_CLIENTS 32
+#define SPECTATOR_TICK_MS 50
+#define SPECTATOR_CLIENT_BUFFER (256 * 1024) // Se agranda si un keyframe no entra
+#define SPECTATOR_FINISH_MS 1000             // Plazo para entregar el final a los clientes
+
+/**
+ * Copia el jugador i del estado al formato del protocolo. El llamador se encarga del lock si hace falta.
+ *
+ * @param p Jugador a completar
+ * @param state Estado del juego
+ * @param i Índice del jugador
+ */
+void spectator_player_from_state(spectator_player_t *p, const game_state_t *state, unsigned int i);
+
+/**
+ * Crea el socket y lanza el proceso servidor.
+ *
+ * @param path Ruta del socket (sólo se reemplaza un socket abandonado, ver unix_socket.h)
+ * @param state Estado del juego, ya inicializado
+ * @param game_sync Sincronización, para copiar el estado si el servidor se atrasa
+ * @param ext Extensiones con el anillo de eventos
+ *
+ * @return PID del servidor, o -1 en caso de error
+ */
+pid_t spectator_server_start(const char *path, const game_state_t *state, game_sync_t *game_sync, game_ext_t *ext);
+
+#endif
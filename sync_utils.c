@@ -1,8 +1,109 @@
 #include "sync_utils.h"
 #include <stdio.h>
 #include <errno.h>
+#include <string.h>
 
-void writer_enter(game_sync_t* sync) {
+// Lock robusto en uso por este proceso (NULL: protocolo de semáforos) y slot de lector reclamado
+static robust_rwlock_t* robust_lock = NULL;
+static int robust_slot = -1;
+// Protocolo con el que entró el proceso a la sección crítica en curso (reader_exit/writer_exit lo liberan)
+static bool robust_reading = false;
+static bool robust_writing = false;
+
+// Toma un mutex robusto; si su dueño murió lo marca consistente y sigue como si lo hubiera liberado
+static int robust_mutex_lock(pthread_mutex_t* mutex, const char* name) {
+    int err = pthread_mutex_lock(mutex);
+    if (err == EOWNERDEAD) {
+        fprintf(stderr, "Aviso: el dueño de %s murió dentro de la sección crítica, recuperando\n", name);
+        err = pthread_mutex_consistent(mutex);
+    }
+    if (err != 0) {
+        fprintf(stderr, "pthread_mutex_lock %s: %s\n", name, strerror(err));
+        return -1;
+    }
+    return 0;
+}
+
+static void robust_mutex_unlock(pthread_mutex_t* mutex, const char* name) {
+    int err = pthread_mutex_unlock(mutex);
+    if (err != 0) {
+        fprintf(stderr, "pthread_mutex_unlock %s: %s\n", name, strerror(err));
+    }
+}
+
+// Reclama un slot libre o uno cuyo dueño ya murió. Si no hay, el proceso pasa a leer con los semáforos.
+static int robust_claim_slot(void) {
+    for (int i = 0; i < LOCK_SLOTS; i++) {
+        int err = pthread_mutex_trylock(&robust_lock->slot_owner[i]);
+        if (err == EOWNERDEAD) {
+            err = pthread_mutex_consistent(&robust_lock->slot_owner[i]);
+        }
+        if (err == 0) {
+            robust_slot = i;
+            return 0;
+        }
+    }
+    fprintf(stderr, "Advertencia: no hay slots libres en el lock robusto (máximo %d lectores), se usan los semáforos\n", LOCK_SLOTS);
+    robust_lock = NULL;
+    return -1;
+}
+
+void sync_use_robust_lock(robust_rwlock_t* lock) {
+    robust_lock = lock;
+    robust_slot = -1;
+}
+
+void sync_release_robust_lock(void) {
+    if (robust_lock != NULL && robust_slot >= 0) {
+        robust_mutex_unlock(&robust_lock->slot_owner[robust_slot], "slot_owner");
+    }
+    robust_lock = NULL;
+    robust_slot = -1;
+}
+
+// Retorna false si no pudo tomar el lock; en ese caso no queda nada tomado
+static bool robust_writer_enter(void) {
+    if (robust_mutex_lock(&robust_lock->gate, "gate") == -1) {
+        return false;
+    }
+    // Esperar a que cada lector salga (o muera) de su sección crítica
+    for (int i = 0; i < LOCK_SLOTS; i++) {
+        if (robust_mutex_lock(&robust_lock->slot_read[i], "slot_read") == -1) {
+            while (--i >= 0) {
+                robust_mutex_unlock(&robust_lock->slot_read[i], "slot_read");
+            }
+            robust_mutex_unlock(&robust_lock->gate, "gate");
+            return false;
+        }
+    }
+    return true;
+}
+
+static void robust_writer_exit(void) {
+    for (int i = 0; i < LOCK_SLOTS; i++) {
+        robust_mutex_unlock(&robust_lock->slot_read[i], "slot_read");
+    }
+    robust_mutex_unlock(&robust_lock->gate, "gate");
+}
+
+// Retorna false si no pudo entrar (sin slot o lock inutilizable); en ese caso no queda nada tomado
+static bool robust_reader_enter(void) {
+    if (robust_slot < 0 && robust_claim_slot() == -1) {
+        return false;
+    }
+    if (robust_mutex_lock(&robust_lock->gate, "gate (reader)") == -1) {
+        return false;
+    }
+    int locked = robust_mutex_lock(&robust_lock->slot_read[robust_slot], "slot_read (reader)");
+    robust_mutex_unlock(&robust_lock->gate, "gate (reader)");
+    return locked == 0;
+}
+
+static void robust_reader_exit(void) {
+    robust_mutex_unlock(&robust_lock->slot_read[robust_slot], "slot_read (reader)");
+}
+
+static void sem_writer_enter(game_sync_t* sync) {
     if (sem_wait(&sync->master_access_mutex) == -1) {
         perror("sem_wait master_access_mutex");
         return;
@@ -15,7 +116,7 @@ void writer_enter(game_sync_t* sync) {
     }
 }
 
-void writer_exit(game_sync_t* sync) {
+static void sem_writer_exit(game_sync_t* sync) {
     if (sem_post(&sync->game_state_mutex) == -1) {
         perror("sem_post game_state_mutex");
     }
@@ -25,7 +126,7 @@ void writer_exit(game_sync_t* sync) {
     }
 }
 
-void reader_enter(game_sync_t* sync) {
+static void sem_reader_enter(game_sync_t* sync) {
     if (sem_wait(&sync->master_access_mutex) == -1) {
         perror("sem_wait master_access_mutex (reader)");
         return;
@@ -58,7 +159,7 @@ void reader_enter(game_sync_t* sync) {
     }
 }
 
-void reader_exit(game_sync_t* sync) {
+static void sem_reader_exit(game_sync_t* sync) {
     if (sem_wait(&sync->readers_count_mutex) == -1) {
         perror("sem_wait readers_count_mutex (exit)");
         return;
@@ -77,6 +178,40 @@ void reader_exit(game_sync_t* sync) {
     }
 }
 
+/*
+ * Con el lock robusto el escritor toma los dos protocolos: los procesos que no llaman a
+ * sync_use_robust_lock (por ejemplo una vista externa) siguen leyendo con los semáforos y deben quedar
+ * excluidos igual. Un lector usa uno solo: el robusto si pudo reclamar un slot, y si no los semáforos.
+ */
+void writer_enter(game_sync_t* sync) {
+    sem_writer_enter(sync);
+    robust_writing = robust_lock != NULL && robust_writer_enter();
+}
+
+void writer_exit(game_sync_t* sync) {
+    if (robust_writing) {
+        robust_writer_exit();
+        robust_writing = false;
+    }
+    sem_writer_exit(sync);
+}
+
+void reader_enter(game_sync_t* sync) {
+    robust_reading = robust_lock != NULL && robust_reader_enter();
+    if (!robust_reading) {
+        sem_reader_enter(sync);
+    }
+}
+
+void reader_exit(game_sync_t* sync) {
+    if (robust_reading) {
+        robust_reader_exit();
+        robust_reading = false;
+    } else {
+        sem_reader_exit(sync);
+    }
+}
+
 // Funciones para sincronización vista-master
 
 void notify_view(game_sync_t* sync) {
@@ -91,12 +226,39 @@ void wait_view_done(game_sync_t* sync) {
     }
 }
 
+bool wait_view_done_until(game_sync_t* sync, const struct timespec* deadline) {
+    while (sem_timedwait(&sync->view_done_sem, deadline) == -1) {
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != ETIMEDOUT) {
+            perror("sem_timedwait view_done_sem");
+        }
+        return false;
+    }
+    return true;
+}
+
 void wait_view_notification(game_sync_t* sync) {
     if (sem_wait(&sync->update_view_sem) == -1) {
         perror("sem_wait update_view_sem");
     }
 }
 
+bool wait_view_notification_until(game_sync_t* sync, const struct timespec* deadline) {
+    while (sem_timedwait(&sync->update_view_sem, deadline) == -1) {
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == ETIMEDOUT) {
+            return false;
+        }
+        perror("sem_timedwait update_view_sem");
+        break;
+    }
+    return true;
+}
+
 void notify_view_done(game_sync_t* sync) {
     if (sem_post(&sync->view_done_sem) == -1) {
         perror("sem_post view_done_sem");
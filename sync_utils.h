@@ -10,10 +10,20 @@ void writer_exit(game_sync_t* sync);
 void reader_enter(game_sync_t* sync);
 void reader_exit(game_sync_t* sync);
 
+// Lock robusto: a partir de esta llamada reader_* usa el lock de /game_ext en lugar de los semáforos (si no
+// consigue un slot, vuelve a los semáforos) y writer_* toma ambos, para excluir también a quien no lo usa
+void sync_use_robust_lock(robust_rwlock_t* lock);
+// Libera el slot de lector del proceso (opcional: si el proceso muere, el slot se recupera solo)
+void sync_release_robust_lock(void);
+
 // Funciones para sincronización vista-master
 void notify_view(game_sync_t* sync);
 void wait_view_done(game_sync_t* sync);
+// Como wait_view_done pero con plazo absoluto en CLOCK_REALTIME. Retorna false si la vista no respondió a tiempo.
+bool wait_view_done_until(game_sync_t* sync, const struct timespec* deadline);
 void wait_view_notification(game_sync_t* sync);
+// Como wait_view_notification pero con plazo absoluto en CLOCK_REALTIME. Retorna false sólo si venció el plazo.
+bool wait_view_notification_until(game_sync_t* sync, const struct timespec* deadline);
 void notify_view_done(game_sync_t* sync);
 
 // Funciones para sincronización master-jugadores
@@ -0,0 +1,87 @@
+#include "unix_socket.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+// Quita la ruta si es un socket sin servidor. Devuelve 0 si la ruta queda libre, -1 si no se puede usar
+static int remove_stale_socket(const char *path, const struct sockaddr_un *addr, const char *what) {
+    struct stat st;
+    if (lstat(path, &st) == -1) {
+        if (errno == ENOENT) {
+            return 0;
+        }
+        perror("lstat");
+        return -1;
+    }
+    if (!S_ISSOCK(st.st_mode)) {
+        fprintf(stderr, "Error: '%s' existe y no es un socket; no se reemplaza (%s)\n", path, what);
+        return -1;
+    }
+
+    int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe == -1) {
+        perror("socket");
+        return -1;
+    }
+    int in_use = connect(probe, (const struct sockaddr *)addr, sizeof(*addr)) == 0;
+    close(probe);
+    if (in_use) {
+        fprintf(stderr, "Error: ya hay un servidor escuchando en '%s' (%s)\n", path, what);
+        return -1;
+    }
+    if (unlink(path) == -1 && errno != ENOENT) {
+        perror("unlink");
+        return -1;
+    }
+    return 0;
+}
+
+int unix_socket_listen(const char *path, int backlog, bool owner_only, const char *what) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Error: ruta de socket demasiado larga: '%s'\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    if (remove_stale_socket(path, &addr, what) == -1) {
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        perror("socket");
+        return -1;
+    }
+
+    // El bind crea el archivo con los permisos que deja la umask: restringirla evita una ventana entre
+    // el bind y un chmod posterior en la que cualquiera podría conectarse
+    mode_t old_mask = 0;
+    if (owner_only) {
+        old_mask = umask(0077);
+    }
+    int bound = bind(fd, (struct sockaddr *)&addr, sizeof(addr));
+    int bind_errno = errno;
+    if (owner_only) {
+        umask(old_mask);
+    }
+    if (bound == -1) {
+        errno = bind_errno;
+        fprintf(stderr, "bind (%s): %s\n", what, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    if (listen(fd, backlog) == -1) {
+        fprintf(stderr, "listen (%s): %s\n", what, strerror(errno));
+        close(fd);
+        unlink(path);
+        return -1;
+    }
+    return fd;
+}
@@ -0,0 +1,25 @@
+#ifndef UNIX_SOCKET_H
+#define UNIX_SOCKET_H
+
+#include <stdbool.h>
+
+/*
+ * Socket Unix de escucha para los servidores del master (control y espectadores). Si la ruta ya existe,
+ * sólo se reemplaza un socket abandonado: un archivo que no es socket, o un socket con otro servidor
+ * escuchando, es un error y no se toca.
+ */
+
+/**
+ * Crea, enlaza y pone a escuchar un socket Unix no bloqueante (SOCK_CLOEXEC).
+ *
+ * @param path Ruta del socket
+ * @param backlog Conexiones pendientes aceptadas por listen
+ * @param owner_only Si es true, el socket se crea con permisos 0600 (umask 0077 durante el bind, sin
+ *                   ventana con otros permisos)
+ * @param what Descripción para los mensajes de error, por ejemplo "socket de control"
+ *
+ * @return Descriptor del socket, o -1 en caso de error
+ */
+int unix_socket_listen(const char *path, int backlog, bool owner_only, const char *what);
+
+#endif
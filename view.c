@@ -1,5 +1,9 @@
 #include "shared_memory.h"
 #include "sync_utils.h"
+#include "board_access.h"
+#include "board_stats.h"
+#include "reward_index.h"
+#include "color_scheme.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -8,23 +12,42 @@
 #include <ncurses.h>
 #include <sys/stat.h>
 #include <stdarg.h>
+#include <time.h>
 
 // Variables globales
 game_state_t *game_state = NULL;
 game_sync_t *game_sync = NULL;
+game_ext_t *game_ext = NULL;
 int shm_state_fd = -1;
 int shm_sync_fd = -1;
 bool cleanup_done = false;
 unsigned short width, height, player_count;
 
-// Colores para ncurses
-#define COLOR_BOARD_BG 1
-#define COLOR_PLAYER1 2
-#define COLOR_PLAYER2 3
-#define COLOR_PLAYER3 4
-#define COLOR_PLAYER4 5
-#define COLOR_SCORE 6
-#define COLOR_CAPTURED 7
+#define CELL_WIDTH 3        // Columnas de pantalla por celda (o por bloque con zoom)
+#define HEATMAP_SAMPLES 4   // Muestras por lado al estimar el dueño mayoritario de un bloque
+#define HEATMAP_RAMP " .:-=+*#%@"
+#define KEY_POLL_MS 20      // Mientras no llega un frame, cada cuánto se atienden las teclas del viewport
+#define SCOREBOARD_SCAN_FRAMES 16 // Sin /game_ext, cada cuántos frames se recorre el tablero para el marcador
+
+typedef enum
+{
+    HEATMAP_DENSITY, // Recompensa promedio del bloque
+    HEATMAP_OWNER    // Jugador con más celdas en el bloque
+} heatmap_mode_t;
+
+/*
+ * Parte del tablero que se dibuja. Con zoom z cada celda de pantalla representa un bloque de z x z celdas,
+ * así que el costo de cada cuadro depende del tamaño de la terminal y no del tablero.
+ */
+typedef struct
+{
+    int origin_x, origin_y; // Celda del tablero en la esquina superior izquierda
+    int cols, rows;         // Celdas de pantalla disponibles
+    int zoom;
+    int max_zoom;           // Zoom con el que entra el tablero completo
+    int follow;             // Jugador al que se sigue, o -1
+    heatmap_mode_t mode;
+} viewport_t;
 
 void cleanup_resources(void)
 {
@@ -39,7 +62,7 @@ void cleanup_resources(void)
     // Desconectar memorias compartidas
     if (game_state != NULL && width > 0 && height > 0) //no debería usar los width y height de game_state?
     {
-        size_t state_size = sizeof(game_state_t) + width * height * sizeof(int);
+        size_t state_size = calculate_game_state_size(width, height);
         unmap_shared_memory(game_state, state_size);
         game_state = NULL;
     }
@@ -50,6 +73,13 @@ void cleanup_resources(void)
         game_sync = NULL;
     }
 
+    if (game_ext != NULL)
+    {
+        sync_release_robust_lock();
+        close_game_ext(game_ext);
+        game_ext = NULL;
+    }
+
     // Cerrar file descriptors
     if (shm_state_fd != -1)
     {
@@ -97,107 +127,345 @@ void print_colored_text(WINDOW *win, int y, int x, int color_pair, const char *f
 void init_colors(void)
 {
     start_color();
-    
-    const int color_defs[][3] = {
-        {COLOR_BOARD_BG, COLOR_BLACK, COLOR_GREEN},
-        {COLOR_PLAYER1, COLOR_BLACK, COLOR_RED},
-        {COLOR_PLAYER2, COLOR_BLACK, COLOR_BLUE},
-        {COLOR_PLAYER3, COLOR_BLACK, COLOR_YELLOW},
-        {COLOR_PLAYER4, COLOR_BLACK, COLOR_MAGENTA},
-        {COLOR_SCORE, COLOR_WHITE, COLOR_BLACK},
-        {COLOR_CAPTURED, COLOR_BLACK, COLOR_WHITE}
-    };
-    
-    for (size_t i = 0; i < sizeof(color_defs) / sizeof(color_defs[0]); i++) {
-        init_pair(color_defs[i][0], color_defs[i][1], color_defs[i][2]);
+
+    // Los colores ANSI de color_scheme.h coinciden con COLOR_BLACK..COLOR_WHITE
+    for (size_t i = 0; i < COLOR_SCHEME_SIZE; i++) {
+        init_pair(color_scheme[i].pair, color_scheme[i].fg, color_scheme[i].bg);
     }
 }
 
-void draw_board(WINDOW *win, game_state_t *state)
+// Menor potencia de dos con la que el tablero entra en el viewport
+int viewport_fit_zoom(const viewport_t *vp, unsigned short board_width, unsigned short board_height)
 {
-    wclear(win);
-    box(win, 0, 0);
-    mvwprintw(win, 0, 2, " ChompChamps Board ");
+    int zoom = 1;
+    while ((board_width + zoom - 1) / zoom > vp->cols || (board_height + zoom - 1) / zoom > vp->rows)
+        zoom *= 2;
+    return zoom;
+}
 
-    int cell_width = 3;
-    
-    // Dibujar el tablero
-    for (int y = 0; y < state->board_height; y++)
+// Centra el viewport en el jugador seguido (si hay) y lo mantiene dentro del tablero
+void viewport_update(viewport_t *vp, const game_state_t *state)
+{
+    int span_x = vp->cols * vp->zoom;
+    int span_y = vp->rows * vp->zoom;
+
+    if (vp->follow >= 0 && vp->follow < state->player_count)
+    {
+        const player_hot_t *hot = PLAYER_HOT(state, vp->follow);
+        vp->origin_x = hot->pos_x - span_x / 2;
+        vp->origin_y = hot->pos_y - span_y / 2;
+    }
+
+    if (vp->origin_x > state->board_width - span_x)
+        vp->origin_x = state->board_width - span_x;
+    if (vp->origin_y > state->board_height - span_y)
+        vp->origin_y = state->board_height - span_y;
+    if (vp->origin_x < 0)
+        vp->origin_x = 0;
+    if (vp->origin_y < 0)
+        vp->origin_y = 0;
+}
+
+void draw_cell(WINDOW *win, int pos_y, int pos_x, const game_state_t *state, int x, int y)
+{
+    int cell_value = BOARD_CELL(state, x, y);
+    if (cell_value > 0)
+    {
+        print_colored_text(win, pos_y, pos_x, COLOR_BOARD_BG, "%2d", cell_value);
+    }
+    else // cell_value <= 0
+    {
+        int player_idx = -cell_value; // Convertimos el valor negativo al índice del jugador
+        if (player_idx < state->player_count) {
+            // Color del jugador que capturó la celda
+            int color_pair = player_color_pair(player_idx);
+            print_colored_text(win, pos_y, pos_x, color_pair, "##");
+        } else {
+            print_colored_text(win, pos_y, pos_x, COLOR_CAPTURED, "##");
+        }
+    }
+}
+
+/*
+ * Bloque [x0, x1) x [y0, y1) en el mapa de calor. La recompensa del bloque sale del índice de /game_ext en
+ * O(log n); el dueño mayoritario (y la densidad, si no hay /game_ext) se estima con a lo sumo
+ * HEATMAP_SAMPLES x HEATMAP_SAMPLES celdas, así el costo por bloque no depende del zoom.
+ */
+void draw_tile(WINDOW *win, int pos_y, int pos_x, const game_state_t *state, heatmap_mode_t mode,
+               int x0, int y0, int x1, int y1)
+{
+    int step_x = (x1 - x0 + HEATMAP_SAMPLES - 1) / HEATMAP_SAMPLES;
+    int step_y = (y1 - y0 + HEATMAP_SAMPLES - 1) / HEATMAP_SAMPLES;
+    unsigned int owned[MAX_PLAYERS] = {0};
+    unsigned int samples = 0, free_samples = 0, sampled_reward = 0;
+
+    for (int y = y0 + step_y / 2; y < y1; y += step_y)
     {
-        for (int x = 0; x < state->board_width; x++)
+        for (int x = x0 + step_x / 2; x < x1; x += step_x)
         {
-            int cell_value = state->board[y * state->board_width + x];
-            int pos_x = 2 + (x * cell_width);
-            int pos_y = 1 + y;
-            
-            // chequear si hay un jugador en esta posición
-            bool player_here = false;
-            int player_id = -1;
-            for (unsigned int i = 0; i < state->player_count; i++)
+            int cell_value = BOARD_CELL(state, x, y);
+            samples++;
+            if (cell_value > 0)
             {
-                if (state->players[i].pos_x == x && state->players[i].pos_y == y)
-                {
-                    player_here = true;
-                    player_id = i;
-                    break;
-                }
+                free_samples++;
+                sampled_reward += (unsigned int)cell_value;
             }
-            
-            if (player_here)
+            else if (-cell_value < state->player_count)
             {
-                int color_pair = COLOR_PLAYER1 + (player_id % 4);
-                print_colored_text(win, pos_y, pos_x, color_pair, "P%u", player_id + 1);
+                owned[-cell_value]++;
             }
-            else if (cell_value > 0)
+        }
+    }
+
+    if (mode == HEATMAP_OWNER)
+    {
+        int owner = -1;
+        unsigned int best = free_samples;
+        for (unsigned int i = 0; i < state->player_count; i++)
+        {
+            if (owned[i] > best)
             {
-                print_colored_text(win, pos_y, pos_x, COLOR_BOARD_BG, "%2d", cell_value);
+                best = owned[i];
+                owner = (int)i;
             }
-            else // cel_vallue <= 0
+        }
+        if (owner >= 0)
+        {
+            print_colored_text(win, pos_y, pos_x, player_color_pair(owner), "##");
+            return;
+        }
+    }
+
+    // Recompensa promedio por celda (0..9) como un caracter de la rampa
+    unsigned int level;
+    if (game_ext != NULL)
+    {
+        long long cells = (long long)(x1 - x0) * (y1 - y0);
+        level = (unsigned int)(reward_index_rect(game_ext, x0, y0, x1, y1) / cells);
+    }
+    else
+    {
+        level = samples > 0 ? sampled_reward / samples : 0;
+    }
+    char glyph = HEATMAP_RAMP[level > 9 ? 9 : level];
+    print_colored_text(win, pos_y, pos_x, level > 0 ? COLOR_BOARD_BG : COLOR_CAPTURED, "%c%c", glyph, glyph);
+}
+
+void draw_board(WINDOW *win, game_state_t *state, viewport_t *vp)
+{
+    // werase en lugar de wclear: ncurses sólo reescribe en la terminal lo que cambió
+    werase(win);
+    box(win, 0, 0);
+    viewport_update(vp, state);
+
+    if (vp->zoom == 1)
+        mvwprintw(win, 0, 2, " ChompChamps Board ");
+    else
+        mvwprintw(win, 0, 2, " ChompChamps Board 1:%d %s ", vp->zoom, vp->mode == HEATMAP_OWNER ? "owner" : "density");
+    if (vp->follow >= 0)
+        wprintw(win, " following P%d ", vp->follow + 1);
+
+    // Dibujar las celdas (o bloques) visibles
+    for (int sy = 0; sy < vp->rows; sy++)
+    {
+        int y0 = vp->origin_y + sy * vp->zoom;
+        if (y0 >= state->board_height)
+            break;
+        for (int sx = 0; sx < vp->cols; sx++)
+        {
+            int x0 = vp->origin_x + sx * vp->zoom;
+            if (x0 >= state->board_width)
+                break;
+            int pos_x = 2 + (sx * CELL_WIDTH);
+            int pos_y = 1 + sy;
+            if (vp->zoom == 1)
+            {
+                draw_cell(win, pos_y, pos_x, state, x0, y0);
+            }
+            else
             {
-                int player_idx = -cell_value; // Convertimos el valor negativo al índice del jugador
-                if (player_idx < state->player_count) {
-                    // Color del jugador que capturó la celda
-                    int color_pair = COLOR_PLAYER1 + (player_idx % 4);
-                    print_colored_text(win, pos_y, pos_x, color_pair, "##");
-                } else {
-                    print_colored_text(win, pos_y, pos_x, COLOR_CAPTURED, "##");
-                }
+                int x1 = x0 + vp->zoom < state->board_width ? x0 + vp->zoom : state->board_width;
+                int y1 = y0 + vp->zoom < state->board_height ? y0 + vp->zoom : state->board_height;
+                draw_tile(win, pos_y, pos_x, state, vp->mode, x0, y0, x1, y1);
             }
         }
     }
-    
-    wrefresh(win);
+
+    // Jugadores visibles, encima de las celdas
+    for (unsigned int i = 0; i < state->player_count; i++)
+    {
+        int sx = (PLAYER_HOT(state, i)->pos_x - vp->origin_x);
+        int sy = (PLAYER_HOT(state, i)->pos_y - vp->origin_y);
+        if (sx < 0 || sy < 0)
+            continue;
+        sx /= vp->zoom;
+        sy /= vp->zoom;
+        if (sx >= vp->cols || sy >= vp->rows)
+            continue;
+        int color_pair = player_color_pair(i);
+        print_colored_text(win, 1 + sy, 2 + sx * CELL_WIDTH, color_pair, "P%u", i + 1);
+    }
+
+    if (vp->max_zoom > 1)
+        mvwprintw(win, vp->rows + 1, 2, " (%d,%d) arrows +/- f m 0 ", vp->origin_x, vp->origin_y);
+
+    wnoutrefresh(win);
+}
+
+// Aplica una tecla al viewport. Retorna true si hay que redibujar el tablero.
+bool viewport_handle_key(viewport_t *vp, int ch, unsigned short player_count)
+{
+    int step_x = vp->cols * vp->zoom / 4 > 0 ? vp->cols * vp->zoom / 4 : 1;
+    int step_y = vp->rows * vp->zoom / 4 > 0 ? vp->rows * vp->zoom / 4 : 1;
+
+    switch (ch)
+    {
+    case KEY_LEFT:
+    case 'h':
+        vp->origin_x -= step_x;
+        vp->follow = -1;
+        return true;
+    case KEY_RIGHT:
+    case 'l':
+        vp->origin_x += step_x;
+        vp->follow = -1;
+        return true;
+    case KEY_UP:
+    case 'k':
+        vp->origin_y -= step_y;
+        vp->follow = -1;
+        return true;
+    case KEY_DOWN:
+    case 'j':
+        vp->origin_y += step_y;
+        vp->follow = -1;
+        return true;
+    case '+':
+    case '=':
+    case '-':
+    {
+        // Cambiar el zoom manteniendo el centro de la vista
+        int center_x = vp->origin_x + vp->cols * vp->zoom / 2;
+        int center_y = vp->origin_y + vp->rows * vp->zoom / 2;
+        if (ch == '-' && vp->zoom < vp->max_zoom)
+            vp->zoom *= 2;
+        else if (ch != '-' && vp->zoom > 1)
+            vp->zoom /= 2;
+        vp->origin_x = center_x - vp->cols * vp->zoom / 2;
+        vp->origin_y = center_y - vp->rows * vp->zoom / 2;
+        return true;
+    }
+    case '0':
+        vp->zoom = vp->max_zoom;
+        vp->origin_x = vp->origin_y = 0;
+        vp->follow = -1;
+        return true;
+    case 'f':
+        // Siguiente jugador; después del último se deja de seguir
+        vp->follow = vp->follow + 1 < player_count ? vp->follow + 1 : -1;
+        return true;
+    case 'm':
+        vp->mode = vp->mode == HEATMAP_DENSITY ? HEATMAP_OWNER : HEATMAP_DENSITY;
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Atiende las teclas pendientes y, si movieron el viewport, redibuja el tablero
+void poll_viewport_keys(WINDOW *board_win, viewport_t *vp)
+{
+    bool redraw = false;
+    int ch;
+    while ((ch = wgetch(board_win)) != ERR)
+        redraw |= viewport_handle_key(vp, ch, player_count);
+    if (redraw)
+    {
+        reader_enter(game_sync);
+        draw_board(board_win, game_state, vp);
+        reader_exit(game_sync);
+        doupdate();
+    }
+}
+
+// Espera el próximo frame sin dejar de atender las teclas: con la partida en pausa, trabada o durante la
+// demora del master el viewport se sigue pudiendo mover
+void wait_frame(WINDOW *board_win, viewport_t *vp)
+{
+    for (;;)
+    {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += KEY_POLL_MS * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        if (wait_view_notification_until(game_sync, &deadline))
+            return;
+        poll_viewport_keys(board_win, vp);
+    }
+}
+
+/*
+ * Totales del marcador sin recorrer el tablero: con /game_ext las celdas libres y la recompensa restante
+ * las mantiene el master, y cada jugador tiene su celda inicial más una por movimiento válido. Sin
+ * /game_ext se recorre el tablero cada SCOREBOARD_SCAN_FRAMES frames (y en el último).
+ */
+static void scoreboard_stats(game_state_t *state, board_stats_t *stats)
+{
+    static board_stats_t scanned;
+    static unsigned long frames = 0;
+
+    if (game_ext != NULL)
+    {
+        memset(stats, 0, sizeof(*stats));
+        stats->free_cells = game_ext->free_cells;
+        stats->remaining_reward = (unsigned long long)reward_index_total(game_ext);
+        for (unsigned int i = 0; i < state->player_count; i++)
+            stats->owned[i] = PLAYER_HOT(state, i)->valid_moves + 1ul;
+        return;
+    }
+    if (frames++ % SCOREBOARD_SCAN_FRAMES == 0 || state->game_over)
+        board_stats_compute(state, &scanned);
+    *stats = scanned;
 }
 
 void draw_scoreboard(WINDOW *win, game_state_t *state)
 {
-    wclear(win);
+    werase(win);
     box(win, 0, 0);
     mvwprintw(win, 0, 2, " Scoreboard ");
 
+    board_stats_t stats;
+    scoreboard_stats(state, &stats);
+    mvwprintw(win, 0, 16, " Free: %lu  Reward left: %llu ", stats.free_cells, stats.remaining_reward);
+
     wattron(win, COLOR_PAIR(COLOR_SCORE));
     
     for (unsigned int i = 0; i < state->player_count; i++)
     {
-        int color_pair = COLOR_PLAYER1 + (i % 4);
+        int color_pair = player_color_pair(i);
         print_colored_text(win, i+1, 2, color_pair, "P%u", i+1);
 
         wattron(win, COLOR_PAIR(COLOR_SCORE));
-        mvwprintw(win, i+1, 5, "%-15s Score: %4u  Moves: %3u/%3u %s", 
+        mvwprintw(win, i+1, 5, "%-15s Score: %4u  Cells: %4lu  Moves: %3u/%3u %s", 
                 state->players[i].player_name,
-                state->players[i].score,
-                state->players[i].valid_moves,
-                state->players[i].invalid_moves,
-                state->players[i].is_blocked ? "[BLOCKED]" : "");
+                PLAYER_HOT(state, i)->score,
+                stats.owned[i],
+                PLAYER_HOT(state, i)->valid_moves,
+                PLAYER_HOT(state, i)->invalid_moves,
+                PLAYER_HOT(state, i)->is_blocked ? "[BLOCKED]" : "");
     }
     
     wattroff(win, COLOR_PAIR(COLOR_SCORE));
-    wrefresh(win);
+    wnoutrefresh(win);
 }
 
 void draw_legend(WINDOW *win, unsigned short player_count, player_t players[])
 {
-    wclear(win);
+    werase(win);
     box(win, 0, 0);
     mvwprintw(win, 0, 2, " Legend ");
     
@@ -208,15 +476,14 @@ void draw_legend(WINDOW *win, unsigned short player_count, player_t players[])
     wprintw(win, " - Captured cell");
     
     for (unsigned int i = 0; i < player_count; i++) {
-        int color_pair = COLOR_PLAYER1 + (i % 4);
+        int color_pair = player_color_pair(i);
         
         int row = 3 + i;
         print_colored_text(win, row, 2, color_pair, "P%u", i+1);
         wprintw(win, " - %s", players[i].player_name);
     }
-    
-    
-    wrefresh(win);
+
+    wnoutrefresh(win);
 }
 
 int main(int argc, char *argv[])
@@ -241,6 +508,13 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
+    // Extensiones opcionales: sin /game_ext se usa el protocolo de semáforos
+    game_ext = open_game_ext();
+    if (game_ext != NULL && game_ext->lock_mode == LOCK_MODE_ROBUST)
+    {
+        sync_use_robust_lock(&game_ext->robust_lock);
+    }
+
     // Abrir memoria compartida del estado del juego
     shm_state_fd = open_shared_memory(GAME_STATE_NAME, 0, O_RDONLY);
     if (shm_state_fd == -1)
@@ -293,14 +567,26 @@ int main(int argc, char *argv[])
     int max_y, max_x;
     getmaxyx(stdscr, max_y, max_x);
     
-    int board_height = height + 2;  // +2 para los bordes
-    int board_width = width * 3 + 4;  // 3 caracteres por celda + bordes
-    
     int scoreboard_height = player_count + 2;  // +2 para los bordes
     int scoreboard_width = max_x - 2;  // Ancho casi completo
     
     int legend_height = player_count + 4;
     int legend_width = 30;
+
+    // El tablero ocupa lo que necesita, hasta lo que dejan libre el scoreboard y la leyenda
+    viewport_t viewport = {0, 0, width, height, 1, 1, -1, HEATMAP_DENSITY};
+    int max_rows = max_y - scoreboard_height - legend_height - 6;
+    int max_cols = (max_x - 6) / CELL_WIDTH;
+    if (viewport.rows > max_rows)
+        viewport.rows = max_rows > 1 ? max_rows : 1;
+    if (viewport.cols > max_cols)
+        viewport.cols = max_cols > 1 ? max_cols : 1;
+    viewport.max_zoom = viewport_fit_zoom(&viewport, width, height);
+    if (viewport.max_zoom > 1)
+        viewport.follow = 0; // El tablero no entra: se empieza siguiendo al primer jugador
+
+    int board_height = viewport.rows + 2;  // +2 para los bordes
+    int board_width = viewport.cols * CELL_WIDTH + 4;  // 3 caracteres por celda + bordes
     
     WINDOW *board_win = newwin(board_height, board_width, 1, (max_x - board_width) / 2);
     WINDOW *scoreboard_win = newwin(scoreboard_height, scoreboard_width, board_height + 1, 1);
@@ -313,12 +599,16 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
     
+    // Teclas del viewport sin bloquear el loop
+    keypad(board_win, TRUE);
+    nodelay(board_win, TRUE);
+
     notify_view_done(game_sync);
     
     // Loop principal
     bool game_over_aux = false;
     while(1){
-        wait_view_notification(game_sync);
+        wait_frame(board_win, &viewport);
         
         // Lectura segura del estado del juego
         reader_enter(game_sync);
@@ -326,7 +616,7 @@ int main(int argc, char *argv[])
         reader_exit(game_sync);
 
         // Actualizar la interfaz
-        draw_board(board_win, game_state);
+        draw_board(board_win, game_state, &viewport);
         draw_scoreboard(scoreboard_win, game_state);
         draw_legend(legend_win, player_count, game_state->players);
         doupdate(); 
@@ -337,8 +627,12 @@ int main(int argc, char *argv[])
             break;
         }
         
-        // pausa para no consumir CPU
-        napms(50);
+        // pausa para no consumir CPU, atendiendo las teclas del viewport
+        for (int slice = 0; slice < 5; slice++)
+        {
+            poll_viewport_keys(board_win, &viewport);
+            napms(10);
+        }
     };
 
     napms(2000);
@@ -0,0 +1,56 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "shared_memory.h"
+#include "board_access.h"
+#include <stdint.h>
+
+/*
+ * Hash Zobrist de 64 bits del tablero y de las posiciones de los jugadores. El hash es el XOR de una clave
+ * por cada (celda, valor) y otra por cada (jugador, celda en la que está), así que un movimiento lo
+ * actualiza en O(1) con cuatro XOR: sale la recompensa de la celda y entra el valor capturado, y el
+ * jugador deja una celda y ocupa otra.
+ *
+ * Las claves no se guardan en una tabla: se derivan con splitmix64 del índice lógico de la celda
+ * (y * ancho + x), del valor y del jugador, de modo que cualquier proceso obtiene las mismas claves sin
+ * compartir memoria y el hash no depende del formato del tablero (PADDED_BOARD).
+ */
+
+#define ZOBRIST_SEED 0x5bd1e9955bd1e995ull
+
+static inline uint64_t zobrist_mix(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Clave de la celda con índice lógico cell cuando vale value (recompensa 1..9 o -jugador)
+static inline uint64_t zobrist_cell_key(uint32_t cell, int value)
+{
+    return zobrist_mix(ZOBRIST_SEED ^ ((uint64_t)cell << 8) ^ (uint64_t)(uint8_t)(value + 64));
+}
+
+// Clave del jugador player ubicado en la celda con índice lógico cell
+static inline uint64_t zobrist_player_key(unsigned int player, uint32_t cell)
+{
+    return zobrist_mix(~ZOBRIST_SEED ^ ((uint64_t)cell << 8) ^ player);
+}
+
+// Hash completo, recorriendo todo el tablero
+static inline uint64_t zobrist_hash_state(const game_state_t *state)
+{
+    uint64_t hash = 0;
+    for (unsigned short y = 0; y < state->board_height; ++y)
+        for (unsigned short x = 0; x < state->board_width; ++x)
+            hash ^= zobrist_cell_key((uint32_t)y * state->board_width + x, BOARD_CELL(state, x, y));
+    for (unsigned int p = 0; p < state->player_count; ++p)
+    {
+        const player_hot_t *hot = PLAYER_HOT(state, p);
+        hash ^= zobrist_player_key(p, (uint32_t)hot->pos_y * state->board_width + hot->pos_x);
+    }
+    return hash;
+}
+
+#endif